@@ -0,0 +1,115 @@
+// ======================================================================
+//  Module : assets.c
+//  Description : Paquet de ressources projeté depuis la partition "assets"
+//  Fonctionnement :
+//     - Le paquet (scénario, caractères LCD, ...) est construit sur l’hôte
+//       par tools/asset_pack.py et flashé dans sa propre partition : le
+//       modifier ne demande pas de reflasher l’application.
+//     - Au démarrage, la partition est projetée dans l’espace d’adresses
+//       (cache flash) ; le CRC32 et l’index sont vérifiés en une passe.
+//     - assets_find() retourne un pointeur direct dans la flash :
+//       aucune copie en RAM, le paquet reste projeté jusqu’à l’arrêt.
+// ======================================================================
+
+#include "assets.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "assets";
+
+// Type de la partition "assets" (plage réservée aux applications)
+#define ASSETS_PARTITION_SUBTYPE 0x40
+
+static const asset_pack_header_t *s_pack = NULL;
+static esp_partition_mmap_handle_t s_mmap;
+
+// ----------------------------------------------------------------------
+//  Vérifie l’en-tête, le CRC et l’index d’un paquet
+// ----------------------------------------------------------------------
+esp_err_t assets_validate(const void *pack, size_t len) {
+    const asset_pack_header_t *h = pack;
+    if (len < sizeof(*h) || h->magic != ASSET_PACK_MAGIC) return ESP_ERR_NOT_FOUND;
+    if (h->format != ASSET_PACK_FORMAT) return ESP_ERR_INVALID_VERSION;
+
+    size_t index_end = sizeof(*h) + (size_t)h->count * sizeof(asset_entry_t);
+    if (h->size > len || h->size < index_end) return ESP_ERR_INVALID_SIZE;
+
+    // Une seule passe sur tout le contenu
+    const uint8_t *base = pack;
+    size_t covered = offsetof(asset_pack_header_t, crc32) + sizeof(h->crc32);
+    if (esp_rom_crc32_le(0, base + covered, h->size - covered) != h->crc32) {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    const asset_entry_t *index = (const void *)(h + 1);
+    for (int i = 0; i < h->count; i++) {
+        const asset_entry_t *e = &index[i];
+        if (e->offset < index_end || e->offset % 4 != 0 || e->offset > h->size ||
+            e->size > h->size - e->offset) {                // Soustraction sans débordement
+            return ESP_ERR_INVALID_SIZE;
+        }
+    }
+    return ESP_OK;
+}
+
+// ----------------------------------------------------------------------
+//  Projection de la partition et vérification
+// ----------------------------------------------------------------------
+esp_err_t assets_load(void) {
+    if (s_pack != NULL) return ESP_OK;
+
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           ASSETS_PARTITION_SUBTYPE, "assets");
+    if (part == NULL) {
+        ESP_LOGE(TAG, "Partition \"assets\" absente");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const void *pack;
+    esp_err_t err = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &pack, &s_mmap);
+    if (err != ESP_OK) return err;
+
+    err = assets_validate(pack, part->size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Paquet invalide (%s)", esp_err_to_name(err));
+        esp_partition_munmap(s_mmap);
+        return err;
+    }
+
+    s_pack = pack;
+    ESP_LOGI(TAG, "Paquet v%lu : %d ressources, %lu octets",
+             (unsigned long)s_pack->version, s_pack->count, (unsigned long)s_pack->size);
+    return ESP_OK;
+}
+
+// ----------------------------------------------------------------------
+//  Recherche une ressource par nom et type
+//  Retourne un pointeur dans la flash projetée (NULL si absente).
+// ----------------------------------------------------------------------
+const void *assets_find(const char *name, asset_type_t type, size_t *size) {
+    if (s_pack == NULL) return NULL;
+
+    const asset_entry_t *index = (const void *)(s_pack + 1);
+    for (int i = 0; i < s_pack->count; i++) {
+        const asset_entry_t *e = &index[i];
+        if (e->type == type && strncmp(e->name, name, ASSET_NAME_LEN) == 0) {
+            if (size) *size = e->size;
+            return (const uint8_t *)s_pack + e->offset;
+        }
+    }
+    return NULL;
+}
+
+// ----------------------------------------------------------------------
+//  Parcours de l’index (énumération des ressources d’un type)
+// ----------------------------------------------------------------------
+int assets_count(void) {
+    return s_pack ? s_pack->count : 0;
+}
+
+const asset_entry_t *assets_entry(int i) {
+    if (s_pack == NULL || i < 0 || i >= s_pack->count) return NULL;
+    return &((const asset_entry_t *)(s_pack + 1))[i];
+}
@@ -0,0 +1,48 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+// ----------------------------------------------------------------------
+//  Format du paquet de ressources (petit-boutiste)
+//  Doit rester identique à tools/asset_pack.py.
+//
+//  [en-tête][index × count][données alignées sur 4 octets]
+//  Le CRC32 couvre tout ce qui suit le champ crc32 jusqu’à size.
+// ----------------------------------------------------------------------
+#define ASSET_PACK_MAGIC   0x314B5041u   // "APK1"
+#define ASSET_PACK_FORMAT  1
+#define ASSET_NAME_LEN     12
+
+// Types de ressources
+typedef enum {
+    ASSET_SCENARIO = 1,    // Machine à états du jeu (scenario.h), textes inclus
+    ASSET_GLYPHS   = 2,    // Caractères LCD personnalisés, 8 octets chacun
+} asset_type_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t crc32;
+    uint16_t format;         // Version du format
+    uint16_t count;          // Nombre d’entrées de l’index
+    uint32_t size;           // Taille totale du paquet
+    uint32_t version;        // Version du contenu (fixée par l’auteur)
+    uint32_t reserved;
+} asset_pack_header_t;
+
+typedef struct {
+    char name[ASSET_NAME_LEN];   // Complété par des '\0'
+    uint8_t type;
+    uint8_t reserved[3];
+    uint32_t offset;             // Depuis le début du paquet
+    uint32_t size;
+} asset_entry_t;
+
+esp_err_t assets_validate(const void *pack, size_t len);
+esp_err_t assets_load(void);
+const void *assets_find(const char *name, asset_type_t type, size_t *size);
+int assets_count(void);
+const asset_entry_t *assets_entry(int i);
+
+#endif
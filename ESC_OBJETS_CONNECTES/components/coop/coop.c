@@ -0,0 +1,86 @@
+// ======================================================================
+//  Module : coop.c
+//  Description : Ordonnanceur coopératif de protothreads
+//  Fonctionnement :
+//     - Plusieurs tâches sans pile partagent une seule tâche FreeRTOS :
+//       chacune ne coûte que sa structure (quelques dizaines d’octets)
+//       au lieu d’une pile complète.
+//     - coop_run() distribue un message à toutes les tâches actives ;
+//       chacune avance jusqu’à sa prochaine attente puis rend la main.
+//     - Les ressources partagées (écran, clavier, LEDs...) sont des bits :
+//       une tâche les obtient toutes d’un coup ou attend, ce qui évite
+//       les interblocages. Une tâche terminée libère tout ce qu’elle détient.
+// ======================================================================
+
+#include "coop.h"
+#include <stddef.h>
+
+static coop_task_t *s_tasks[COOP_MAX_TASKS];
+static int s_count = 0;
+static uint32_t s_taken = 0;        // Ressources détenues, toutes tâches confondues
+static bool s_released = false;     // Une ressource s’est libérée pendant le passage
+
+// ----------------------------------------------------------------------
+//  Enregistre une tâche (démarrera au prochain coop_run)
+// ----------------------------------------------------------------------
+void coop_add(coop_task_t *task, const char *name, coop_fn_t fn, void *ctx) {
+    if (s_count >= COOP_MAX_TASKS) return;
+
+    PT_INIT(&task->pt);
+    task->fn = fn;
+    task->ctx = ctx;
+    task->name = name;
+    task->owned = 0;
+    task->ended = false;
+    s_tasks[s_count++] = task;
+}
+
+// ----------------------------------------------------------------------
+//  Arbitrage des ressources
+// ----------------------------------------------------------------------
+bool coop_acquire(coop_task_t *task, uint32_t resources) {
+    uint32_t missing = resources & ~task->owned;
+    if (missing & s_taken) return false;     // Au moins une est prise ailleurs
+
+    s_taken |= missing;
+    task->owned |= missing;
+    return true;
+}
+
+void coop_release(coop_task_t *task, uint32_t resources) {
+    uint32_t freed = resources & task->owned;
+    if (freed == 0) return;
+
+    task->owned &= ~freed;
+    s_taken &= ~freed;
+    s_released = true;
+}
+
+// ----------------------------------------------------------------------
+//  Distribue un message à toutes les tâches actives
+//  Si des ressources se libèrent, de nouveaux passages (sans message)
+//  laissent avancer les tâches qui les attendaient.
+// ----------------------------------------------------------------------
+void coop_run(const void *msg) {
+    for (int pass = 0; pass <= COOP_MAX_TASKS; pass++) {
+        s_released = false;
+        for (int i = 0; i < s_count; i++) {
+            coop_task_t *task = s_tasks[i];
+            if (task->ended) continue;
+
+            if (task->fn(task, msg) == PT_ENDED) {
+                task->ended = true;
+                coop_release(task, task->owned);
+            }
+        }
+        if (!s_released) return;
+        msg = NULL;
+    }
+}
+
+bool coop_alive(void) {
+    for (int i = 0; i < s_count; i++) {
+        if (!s_tasks[i]->ended) return true;
+    }
+    return false;
+}
@@ -0,0 +1,33 @@
+#ifndef COOP_H
+#define COOP_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "pt.h"
+
+#define COOP_MAX_TASKS 4
+
+typedef struct coop_task coop_task_t;
+
+// Corps d’une tâche : protothread appelé à chaque passage,
+// msg = message en cours de distribution (NULL : simple reprise)
+typedef int (*coop_fn_t)(coop_task_t *task, const void *msg);
+
+struct coop_task {
+    pt_t pt;
+    coop_fn_t fn;
+    void *ctx;               // Données propres à la tâche
+    const char *name;
+    uint32_t owned;          // Ressources détenues (bits définis par l’application)
+    bool ended;
+};
+
+void coop_add(coop_task_t *task, const char *name, coop_fn_t fn, void *ctx);
+void coop_run(const void *msg);
+bool coop_alive(void);
+bool coop_acquire(coop_task_t *task, uint32_t resources);
+void coop_release(coop_task_t *task, uint32_t resources);
+
+// Attend de détenir toutes les ressources demandées (tout ou rien)
+#define PT_ACQUIRE(pt, task, res) PT_WAIT_UNTIL(pt, coop_acquire(task, res))
+
+#endif
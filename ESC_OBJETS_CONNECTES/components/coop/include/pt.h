@@ -0,0 +1,41 @@
+#ifndef PT_H
+#define PT_H
+#include <stdint.h>
+
+// ----------------------------------------------------------------------
+//  Protothreads : fils d’exécution sans pile
+//  La position de reprise est mémorisée dans pt->lc (numéro de ligne) ;
+//  les variables locales ne survivent pas à une attente, l’état doit
+//  vivre dans une structure. Un seul PT_WAIT par ligne, pas de switch
+//  entre PT_BEGIN et PT_END.
+// ----------------------------------------------------------------------
+typedef struct {
+    uint16_t lc;
+} pt_t;
+
+#define PT_WAITING 0
+#define PT_ENDED   1
+
+#define PT_INIT(pt)   ((pt)->lc = 0)
+#define PT_BEGIN(pt)  switch ((pt)->lc) { case 0:
+#define PT_END(pt)    } (pt)->lc = 0; return PT_ENDED
+
+// Rend la main tant que la condition est fausse
+#define PT_WAIT_UNTIL(pt, cond)          \
+    do {                                 \
+        (pt)->lc = __LINE__;             \
+        case __LINE__:                   \
+        if (!(cond)) return PT_WAITING;  \
+    } while (0)
+
+#define PT_WAIT_WHILE(pt, cond) PT_WAIT_UNTIL(pt, !(cond))
+
+// Rend la main une fois, reprend au passage suivant
+#define PT_YIELD(pt)                     \
+    do {                                 \
+        (pt)->lc = __LINE__;             \
+        return PT_WAITING;               \
+        case __LINE__:;                  \
+    } while (0)
+
+#endif
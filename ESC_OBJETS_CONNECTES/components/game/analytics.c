@@ -0,0 +1,186 @@
+// ======================================================================
+//  Module : analytics.c
+//  Description : Statistiques des parties (temps, tentatives, indices)
+//  Fonctionnement :
+//     - Pendant une partie, les mesures restent en RAM
+//       (analytics_session_t) : aucune écriture flash pendant le jeu.
+//     - À la fin, un seul lot est validé dans NVS : l’enregistrement de
+//       la partie et les cumuls mis à jour, puis un nvs_commit(). Le
+//       handle est ouvert une fois pour toutes au démarrage, mais NVS
+//       alloue encore pendant l’écriture : seules allocations sur le tas
+//       après le démarrage (heap_guard.h).
+//     - Les parties tournent sur 64 clés ; NVS écrit chaque nouvelle
+//       valeur à la suite dans ses pages (journal) et libère l’ancienne :
+//       l’usure se répartit sur toute la partition "nvs".
+//     - Les temps de résolution alimentent un histogramme à 32 classes
+//       (demi-octaves) : p50/p90 se lisent sans relire l’historique.
+// ======================================================================
+
+#include "analytics.h"
+#include "heap_guard.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "hal_time.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "analytics";
+
+#define ANALYTICS_NAMESPACE "stats"
+#define ANALYTICS_KEY_TOTALS "tot"
+
+static analytics_totals_t s_totals = {.version = ANALYTICS_VERSION};
+static nvs_handle_t s_nvs;
+static bool s_persist = false;
+
+// ----------------------------------------------------------------------
+//  Classe de l’histogramme : 0 = moins d’une seconde, puis
+//  [1 s, 1,41 s[, [1,41 s, 2 s[, [2 s, 2,83 s[, ... (demi-octaves)
+// ----------------------------------------------------------------------
+static int bucket_of(uint32_t ms) {
+    if (ms < 1000) return 0;
+    int idx = 1 + (int)(2.0f * log2f(ms / 1000.0f));
+    return idx < ANALYTICS_BUCKETS ? idx : ANALYTICS_BUCKETS - 1;
+}
+
+static float bucket_low_ms(int idx) {
+    return idx == 0 ? 0.0f : 1000.0f * exp2f((idx - 1) / 2.0f);
+}
+
+static void history_key(char key[4], uint32_t seq) {
+    snprintf(key, 4, "s%02lx", (unsigned long)(seq % ANALYTICS_HISTORY));
+}
+
+// ----------------------------------------------------------------------
+//  Ouvre l’espace NVS et recharge les cumuls
+// ----------------------------------------------------------------------
+void analytics_init(void) {
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());       // Partition d’une autre version
+        err = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(err);
+
+#if CONFIG_GAME_REPLAY
+    nvs_open_mode_t mode = NVS_READONLY;          // Une partie rejouée n’est pas comptée
+#else
+    nvs_open_mode_t mode = NVS_READWRITE;
+#endif
+    if (nvs_open(ANALYTICS_NAMESPACE, mode, &s_nvs) != ESP_OK) {
+        ESP_LOGW(TAG, "Espace \"%s\" absent, statistiques non enregistrées", ANALYTICS_NAMESPACE);
+        return;
+    }
+    s_persist = mode == NVS_READWRITE;
+
+    analytics_totals_t t;
+    size_t len = sizeof(t);
+    if (nvs_get_blob(s_nvs, ANALYTICS_KEY_TOTALS, &t, &len) == ESP_OK &&
+        len == sizeof(t) && t.version == ANALYTICS_VERSION) {
+        s_totals = t;
+    }
+
+    ESP_LOGI(TAG, "%lu partie(s), %lu résolue(s), p50 %lu s, p90 %lu s",
+             (unsigned long)s_totals.sessions, (unsigned long)s_totals.solved,
+             (unsigned long)analytics_percentile_ms(50) / 1000,
+             (unsigned long)analytics_percentile_ms(90) / 1000);
+}
+
+// ----------------------------------------------------------------------
+//  Mesures d’une partie (RAM)
+// ----------------------------------------------------------------------
+void analytics_begin(analytics_session_t *s) {
+    memset(s, 0, sizeof(*s));
+    s->start_us = hal_time_us();
+}
+
+void analytics_attempt(analytics_session_t *s, bool ok) {
+    if (s->attempts < UINT16_MAX) s->attempts++;
+    if (!ok && s->failures < UINT16_MAX) s->failures++;
+}
+
+void analytics_hint(analytics_session_t *s) {
+    if (s->hints < UINT8_MAX) s->hints++;
+}
+
+// ----------------------------------------------------------------------
+//  Fin de partie : cumuls en RAM puis un seul lot écrit en NVS
+// ----------------------------------------------------------------------
+void analytics_end(const analytics_session_t *s, const char *puzzle, bool solved) {
+    analytics_record_t rec = {
+        .seq = s_totals.sessions,
+        .duration_ms = (uint32_t)((hal_time_us() - s->start_us) / 1000),
+        .attempts = s->attempts,
+        .failures = s->failures,
+        .hints = s->hints,
+        .solved = solved,
+    };
+    strncpy(rec.puzzle, puzzle, sizeof(rec.puzzle));
+
+    s_totals.sessions++;
+    s_totals.attempts += rec.attempts;
+    s_totals.failures += rec.failures;
+    s_totals.hints += rec.hints;
+    if (solved) {
+        s_totals.solved++;
+        s_totals.solve_ms_sum += rec.duration_ms;
+        s_totals.hist[bucket_of(rec.duration_ms)]++;
+    }
+
+    ESP_LOGI(TAG, "Partie %lu (%.12s) : %s en %lu s, %u tentative(s), %u indice(s)",
+             (unsigned long)rec.seq, rec.puzzle, solved ? "résolue" : "abandonnée",
+             (unsigned long)rec.duration_ms / 1000, rec.attempts, rec.hints);
+    if (!s_persist) return;
+
+    char key[4];
+    history_key(key, rec.seq);
+    heap_guard_exempt(true);                   // NVS alloue listes et index de pages
+    esp_err_t err = nvs_set_blob(s_nvs, key, &rec, sizeof(rec));
+    if (err == ESP_OK) err = nvs_set_blob(s_nvs, ANALYTICS_KEY_TOTALS, &s_totals, sizeof(s_totals));
+    if (err == ESP_OK) err = nvs_commit(s_nvs);
+    heap_guard_exempt(false);
+    if (err != ESP_OK) ESP_LOGW(TAG, "Enregistrement impossible (%s)", esp_err_to_name(err));
+}
+
+// ----------------------------------------------------------------------
+//  Lecture des statistiques
+// ----------------------------------------------------------------------
+const analytics_totals_t *analytics_totals(void) {
+    return &s_totals;
+}
+
+// Temps de résolution sous lequel se trouvent pct % des parties résolues
+// (interpolé dans la classe ; coût fixe, quel que soit l’historique)
+uint32_t analytics_percentile_ms(unsigned pct) {
+    if (s_totals.solved == 0) return 0;
+    if (pct > 100) pct = 100;
+
+    uint32_t rank = (uint32_t)(((uint64_t)s_totals.solved * pct + 99) / 100);
+    if (rank == 0) rank = 1;
+
+    uint32_t below = 0;
+    for (int i = 0; i < ANALYTICS_BUCKETS; i++) {
+        uint32_t n = s_totals.hist[i];
+        if (below + n >= rank) {
+            float frac = (rank - below - 0.5f) / n;   // Position dans la classe
+            float low = bucket_low_ms(i);
+            float high = i == 0 ? 1000.0f : low * (float)M_SQRT2;
+            return (uint32_t)(i == 0 ? high * frac : low * powf(high / low, frac));
+        }
+        below += n;
+    }
+    return 0;
+}
+
+// Partie seq, si elle fait encore partie des 64 dernières
+bool analytics_history(uint32_t seq, analytics_record_t *rec) {
+    if (seq >= s_totals.sessions || s_totals.sessions - seq > ANALYTICS_HISTORY) return false;
+
+    char key[4];
+    size_t len = sizeof(*rec);
+    history_key(key, seq);
+    return nvs_get_blob(s_nvs, key, rec, &len) == ESP_OK && len == sizeof(*rec) && rec->seq == seq;
+}
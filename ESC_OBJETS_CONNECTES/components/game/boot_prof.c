@@ -0,0 +1,59 @@
+// ======================================================================
+//  Module : boot_prof.c
+//  Description : Chronologie du démarrage, de app_main à l’invite
+//  Fonctionnement :
+//     - Chaque étape note son heure de fin dans un tableau statique
+//       (aucune allocation, utilisable avant l’initialisation du jeu).
+//     - boot_prof_report() affiche, une fois l’invite à l’écran, l’heure
+//       de fin de chaque étape et le total (tag "boot"). Une étape
+//       séquentielle dure depuis l’étape précédente ; une étape
+//       concurrente (init_graph.c) a son propre début, et ces étapes
+//       se chevauchent.
+// ======================================================================
+
+#include "boot_prof.h"
+#include "hal_time.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "boot";
+
+static struct {
+    const char *phase;
+    int64_t start_us;      // -1 : depuis l’étape précédente
+    int64_t t_us;
+} s_marks[BOOT_PROF_MAX];
+static int s_count = 0;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void boot_prof_step(const char *phase, int64_t start_us, int64_t end_us) {
+    portENTER_CRITICAL(&s_lock);
+    if (s_count < BOOT_PROF_MAX) {
+        s_marks[s_count].phase = phase;
+        s_marks[s_count].start_us = start_us;
+        s_marks[s_count].t_us = end_us;
+        s_count++;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void boot_prof_mark(const char *phase) {
+    boot_prof_step(phase, -1, hal_time_us());
+}
+
+// Dixièmes de milliseconde, sans virgule flottante
+#define MS(us)  (long)((us) / 1000), (int)((us) % 1000 / 100)
+
+void boot_prof_report(void) {
+    esp_log_level_set(TAG, ESP_LOG_INFO);          // Visible même avec un niveau global réduit
+    int64_t prev = 0;
+    for (int i = 0; i < s_count; i++) {
+        int64_t start = s_marks[i].start_us >= 0 ? s_marks[i].start_us : prev;
+        ESP_LOGI(TAG, "%-12s %5ld.%d ms  (%s%ld.%d)", s_marks[i].phase, MS(s_marks[i].t_us),
+                 s_marks[i].start_us >= 0 ? "durée " : "+", MS(s_marks[i].t_us - start));
+        if (s_marks[i].t_us > prev) prev = s_marks[i].t_us;
+    }
+    if (s_count > 0) {
+        ESP_LOGI(TAG, "Invite affichée %ld.%d ms après le lancement de l’application", MS(prev));
+    }
+}
@@ -0,0 +1,94 @@
+// ======================================================================
+//  Module : cpu_load.c
+//  Description : Charge par cœur et gigue des entrées
+//  Fonctionnement :
+//     - Les statistiques d’exécution FreeRTOS
+//       (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS, horloge esp_timer en
+//       µs) donnent le temps passé par la tâche inactive de chaque cœur ;
+//       le reste de la période est la charge du cœur.
+//     - La boucle du jeu dépose le délai de chaque entrée dans une file
+//       sans verrou (spsc.h) ; la tâche de relevé la vide et la trie à
+//       chaque période. Un échantillon qui ne trouve pas de place est
+//       ignoré.
+//     - À comparer avec CONFIG_GAME_DUAL_CORE désactivé : même code,
+//       tâches sans affinité.
+// ======================================================================
+
+#include "cpu_load.h"
+#include "sdkconfig.h"
+
+#if CONFIG_GAME_LOAD_REPORT_S
+#include "spsc.h"
+#include "hal_time.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+
+static const char *TAG = "load";
+
+#define LOAD_SAMPLES 128
+
+SPSC_DEFINE(s_latencies, uint32_t, LOAD_SAMPLES);
+
+void cpu_load_input(int64_t latency_us) {
+    uint32_t v = latency_us > 0 ? (uint32_t)latency_us : 0;
+    spsc_push(&s_latencies, &v);
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Temps cumulé de la tâche inactive du cœur (µs, compteur libre)
+static uint32_t idle_us(int core) {
+    return (uint32_t)ulTaskGetRunTimeCounter(xTaskGetIdleTaskHandleForCore(core));
+}
+
+static void cpu_load_task(void *arg) {
+    static uint32_t samples[LOAD_SAMPLES];
+    uint32_t idle0[portNUM_PROCESSORS];
+
+    int64_t t0 = hal_time_us();
+    for (int c = 0; c < portNUM_PROCESSORS; c++) idle0[c] = idle_us(c);
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_GAME_LOAD_REPORT_S * 1000));
+        int64_t t1 = hal_time_us();
+        uint64_t span = (uint64_t)(t1 - t0);
+        t0 = t1;
+
+        for (int c = 0; c < portNUM_PROCESSORS; c++) {
+            uint32_t idle = idle_us(c);
+            uint64_t busy = span - ((idle - idle0[c]) < span ? (idle - idle0[c]) : span);
+            idle0[c] = idle;
+            unsigned permille = (unsigned)(busy * 1000 / span);
+            ESP_LOGI(TAG, "Cœur %d : %u.%u %%", c, permille / 10, permille % 10);
+        }
+
+        int n = 0;
+        while (n < LOAD_SAMPLES && spsc_pop(&s_latencies, &samples[n])) n++;
+        if (n == 0) continue;
+        qsort(samples, n, sizeof(samples[0]), cmp_u32);
+        ESP_LOGI(TAG, "Entrées : %d, délai de prise en charge p50 %lu µs, p99 %lu µs, max %lu µs", n,
+                 (unsigned long)samples[n / 2], (unsigned long)samples[(n * 99 + 99) / 100 - 1],
+                 (unsigned long)samples[n - 1]);
+    }
+}
+
+void cpu_load_start(void) {
+    static StackType_t stack[3072];
+    static StaticTask_t tcb;
+    xTaskCreateStatic(cpu_load_task, "load", sizeof(stack), NULL, 1, stack, &tcb);
+}
+
+#else
+
+void cpu_load_start(void) {
+}
+
+void cpu_load_input(int64_t latency_us) {
+}
+
+#endif
@@ -0,0 +1,268 @@
+// ======================================================================
+//  Module : game_event.c
+//  Description : File d’événements unique de la boucle du jeu
+//  Fonctionnement :
+//     - Chaque source (clavier, bouton, Morse, console, réseau) dépose ses
+//       événements horodatés dans sa propre file sans verrou (spsc.h) :
+//       elle en est le seul producteur, la boucle du jeu le seul
+//       consommateur. Les entrées tournent sur un autre cœur que le jeu
+//       sans qu’aucun verrou ne passe d’un cœur à l’autre.
+//     - Un dépôt réveille la boucle par notification de tâche. La boucle
+//       reste bloquée tant que rien ne se passe ; réveillée, elle prend
+//       l’événement le plus ancien en tête des files.
+//     - Les minuteries du jeu sont des échéances rangées dans un tas
+//       (la plus proche en tête) : l’attente sur la file est bornée par
+//       la première échéance, qui devient un GAME_EVT_TIMER au moment
+//       où elle est consommée. Une seule attente sert toutes les
+//       minuteries : ni tâche, ni esp_timer, ni scrutation par minuterie,
+//       et un délai annulé ne peut plus laisser d’événement en file.
+//     - Le temps est celui de hal_time.h : sur la carte simulée à horloge
+//       pilotée, une attente saute directement à l’échéance.
+//     - Chaque événement consommé est enregistré (journal.c) ; en mode
+//       relecture, la dernière session enregistrée remplace les entrées
+//       réelles et les échéances : le jeu repasse exactement par les
+//       mêmes états, aussi vite que possible.
+// ======================================================================
+
+#include "game_event.h"
+#include "journal.h"
+#include "hal_time.h"
+#include "spsc.h"
+#include "esp_log.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "game_event";
+
+// Profondeur de chaque file : quelques frappes d’avance suffisent
+SPSC_DEFINE(s_keypad_q, game_event_t, 16);
+SPSC_DEFINE(s_button_q, game_event_t, 16);
+SPSC_DEFINE(s_console_q, game_event_t, 16);
+SPSC_DEFINE(s_net_q, game_event_t, 16);
+SPSC_DEFINE(s_morse_q, game_event_t, 16);
+
+static spsc_t *const s_queues[GAME_SRC_COUNT] = {
+    [GAME_SRC_KEYPAD] = &s_keypad_q,
+    [GAME_SRC_BUTTON] = &s_button_q,
+    [GAME_SRC_CONSOLE] = &s_console_q,
+    [GAME_SRC_NET] = &s_net_q,
+    [GAME_SRC_MORSE] = &s_morse_q,
+};
+
+static bool s_ready = false;
+static TaskHandle_t volatile s_consumer = NULL;   // Tâche de la boucle (premier game_event_wait)
+
+// Tas des échéances (tâche du jeu uniquement, aucun verrou)
+typedef struct {
+    int64_t due_us;
+    uint32_t period_us;      // 0 : une seule fois
+    uint8_t id;
+} game_deadline_t;
+
+static game_deadline_t s_heap[GAME_TIMER_COUNT];
+static uint8_t s_heap_len = 0;
+static int8_t s_heap_pos[GAME_TIMER_COUNT];    // Place dans le tas, -1 si inactive
+
+#if CONFIG_GAME_REPLAY
+static journal_reader_t s_replay;
+static bool s_replaying = false;
+static int64_t s_replay_t0;
+#endif
+
+// ----------------------------------------------------------------------
+//  Tas binaire : parent de i en (i - 1) / 2
+// ----------------------------------------------------------------------
+static void heap_set(int i, game_deadline_t d) {
+    s_heap[i] = d;
+    s_heap_pos[d.id] = i;
+}
+
+static void heap_up(int i) {
+    game_deadline_t d = s_heap[i];
+    while (i > 0 && s_heap[(i - 1) / 2].due_us > d.due_us) {
+        heap_set(i, s_heap[(i - 1) / 2]);
+        i = (i - 1) / 2;
+    }
+    heap_set(i, d);
+}
+
+static void heap_down(int i) {
+    game_deadline_t d = s_heap[i];
+    for (;;) {
+        int c = 2 * i + 1;
+        if (c >= s_heap_len) break;
+        if (c + 1 < s_heap_len && s_heap[c + 1].due_us < s_heap[c].due_us) c++;
+        if (s_heap[c].due_us >= d.due_us) break;
+        heap_set(i, s_heap[c]);
+        i = c;
+    }
+    heap_set(i, d);
+}
+
+static void heap_remove(int id) {
+    int i = s_heap_pos[id];
+    if (i < 0) return;
+    s_heap_pos[id] = -1;
+    if (i == --s_heap_len) return;
+
+    game_deadline_t last = s_heap[s_heap_len];  // Le dernier prend la place libérée
+    heap_set(i, last);
+    heap_up(i);
+    heap_down(s_heap_pos[last.id]);
+}
+
+static void heap_insert(int id, int64_t due_us, uint32_t period_us) {
+    heap_remove(id);
+    s_heap[s_heap_len] = (game_deadline_t){.due_us = due_us, .period_us = period_us, .id = id};
+    heap_up(s_heap_len++);
+}
+
+// Échéance consommée : retirée, ou reportée d’une période
+static void heap_fired(int id) {
+    int i = s_heap_pos[id];
+    if (i < 0) return;
+    if (s_heap[i].period_us == 0) {
+        heap_remove(id);
+        return;
+    }
+    s_heap[i].due_us += s_heap[i].period_us;   // Sans dérive : la période suivante part de l’échéance
+    heap_down(i);
+}
+
+// ----------------------------------------------------------------------
+//  Initialisation des échéances et du journal
+// ----------------------------------------------------------------------
+void game_events_init(void) {
+    if (s_ready) return;
+    s_ready = true;
+
+    for (int i = 0; i < GAME_TIMER_COUNT; i++) s_heap_pos[i] = -1;
+
+#if CONFIG_GAME_REPLAY
+    size_t size;
+    const void *log = journal_map(&size);
+    s_replaying = log != NULL && journal_reader_open(&s_replay, log, size);
+    if (s_replaying) ESP_LOGI(TAG, "Relecture de la session %lu", (unsigned long)s_replay.session);
+    else ESP_LOGW(TAG, "Aucune session à rejouer");
+    s_replay_t0 = hal_time_us();
+#elif CONFIG_GAME_JOURNAL
+    journal_start();
+#endif
+}
+
+// ----------------------------------------------------------------------
+//  Dépose un événement (tâche, seul producteur de la source src)
+//  Retourne false si la file est pleine : l’événement est perdu.
+// ----------------------------------------------------------------------
+bool game_event_post(game_source_t src, uint8_t type, uint8_t arg) {
+    game_event_t ev = {.type = type, .arg = arg, .t_us = hal_time_us()};
+    if (!spsc_push(s_queues[src], &ev)) {
+        ESP_LOGW(TAG, "File %d pleine, événement %d perdu", src, type);
+        return false;
+    }
+    TaskHandle_t consumer = s_consumer;
+    if (consumer != NULL) xTaskNotifyGive(consumer);
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Dépose un événement depuis une ISR
+//  Retourne true si une tâche plus prioritaire a été réveillée.
+// ----------------------------------------------------------------------
+bool game_event_post_from_isr(game_source_t src, uint8_t type, uint8_t arg) {
+    BaseType_t woken = pdFALSE;
+    game_event_t ev = {.type = type, .arg = arg, .t_us = hal_time_us()};
+    if (!spsc_push(s_queues[src], &ev)) return false;
+    TaskHandle_t consumer = s_consumer;
+    if (consumer != NULL) vTaskNotifyGiveFromISR(consumer, &woken);
+    return woken == pdTRUE;
+}
+
+// ----------------------------------------------------------------------
+//  Retire l’événement le plus ancien en tête des files (consommateur)
+// ----------------------------------------------------------------------
+static bool events_take(game_event_t *ev) {
+    spsc_t *oldest = NULL;
+    int64_t oldest_t = INT64_MAX;
+    for (int i = 0; i < GAME_SRC_COUNT; i++) {
+        const game_event_t *head = spsc_peek(s_queues[i]);
+        if (head != NULL && head->t_us < oldest_t) {
+            oldest = s_queues[i];
+            oldest_t = head->t_us;
+        }
+    }
+    return oldest != NULL && spsc_pop(oldest, ev);
+}
+
+#if CONFIG_GAME_REPLAY
+// ----------------------------------------------------------------------
+//  Événement suivant de la session rejouée
+//  t_us est remplacé par l’instant de livraison : la latence mesurée par
+//  la boucle du jeu reste le coût du traitement.
+// ----------------------------------------------------------------------
+static bool replay_next(game_event_t *ev) {
+    if (!journal_reader_next(&s_replay, ev)) {
+        s_replaying = false;
+        game_event_t skipped;
+        while (events_take(&skipped)) {}          // Entrées reçues pendant la relecture
+        ESP_LOGI(TAG, "Relecture terminée en %lld ms, retour aux entrées réelles",
+                 (long long)(hal_time_us() - s_replay_t0) / 1000);
+        return false;
+    }
+#if CONFIG_GAME_REPLAY_REALTIME
+    int64_t wait_us = s_replay_t0 + ev->t_us - hal_time_us();
+    if (wait_us > 0) hal_delay_ms((uint32_t)(wait_us / 1000));
+#endif
+    if (ev->type == GAME_EVT_TIMER && ev->arg < GAME_TIMER_COUNT) heap_fired(ev->arg);
+    ev->t_us = hal_time_us();
+    return true;
+}
+#endif
+
+// ----------------------------------------------------------------------
+//  Attend le prochain événement (entrée ou échéance)
+// ----------------------------------------------------------------------
+bool game_event_wait(game_event_t *ev, TickType_t timeout) {
+    if (s_consumer == NULL) s_consumer = xTaskGetCurrentTaskHandle();
+#if CONFIG_GAME_REPLAY
+    if (s_replaying && replay_next(ev)) return true;
+#endif
+    int64_t limit = timeout == portMAX_DELAY ? INT64_MAX
+                                             : hal_time_us() + (int64_t)timeout * portTICK_PERIOD_MS * 1000;
+    for (;;) {
+        int64_t now = hal_time_us();
+        if (s_heap_len > 0 && s_heap[0].due_us <= now) {
+            *ev = (game_event_t){.type = GAME_EVT_TIMER, .arg = s_heap[0].id, .t_us = s_heap[0].due_us};
+            heap_fired(ev->arg);
+            break;
+        }
+
+        if (events_take(ev)) break;
+
+        // Attente bornée par la première échéance (arrondie au tick supérieur) ;
+        // un dépôt arrivé depuis events_take() a laissé sa notification
+        int64_t until = (s_heap_len > 0 && s_heap[0].due_us < limit) ? s_heap[0].due_us : limit;
+        if (ulTaskNotifyTake(pdTRUE, hal_ticks_until(until)) > 0) continue;
+        if (until == limit && hal_time_us() >= limit) return false;
+    }
+#if CONFIG_GAME_JOURNAL && !CONFIG_GAME_REPLAY
+    journal_record(ev);
+#endif
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Arme (ou réarme) une minuterie du jeu
+// ----------------------------------------------------------------------
+void game_timer_start(game_timer_id_t id, uint32_t delay_ms) {
+    heap_insert(id, hal_time_us() + (int64_t)delay_ms * 1000, 0);
+}
+
+// Échéances régulières, la première dans period_ms
+void game_timer_every(game_timer_id_t id, uint32_t period_ms) {
+    heap_insert(id, hal_time_us() + (int64_t)period_ms * 1000, period_ms * 1000);
+}
+
+void game_timer_stop(game_timer_id_t id) {
+    heap_remove(id);
+}
@@ -2,106 +2,184 @@
 //  Commentaires écrits par l'intelligence artificielle
 //  Programme : launch_game()
 //  Description : Logique principale du mini-jeu sur ESP32
-//  Fonctionnement : le joueur doit entrer un code secret sur le clavier
-//  Si le code est correct → LED de réussite s’allume et message de succès
-//  Si le code est incorrect → LED d’erreur clignote et message d’échec
+//  Fonctionnement : le déroulement du jeu (textes, codes, effets, délais)
+//  est décrit par le scénario du paquet de ressources (assets.c,
+//  scenario.c) ; scenarios/b947d.json reproduit l’énigme d’origine.
+//  Architecture : une seule boucle bloquée sur la file d’événements
+//  (game_event.c). Clavier, bouton et minuteries y déposent leurs
+//  événements ; l’ordonnanceur coopératif les distribue aux énigmes
+//  en cours (puzzle.c), une par scénario du paquet.
+//  Cœurs (CONFIG_GAME_DUAL_CORE) : initialisations, ISR, entrées et
+//  rendu de l’écran sur le cœur de app_main ; boucle du jeu dans sa
+//  tâche sur l’autre cœur. Les échanges passent par des files sans
+//  verrou (spsc.h).
 // ======================================================================
 
 #include "led.h"          // Gestion des LED (initialisation, on/off, séquences)
 #include "lcd.h"          // Gestion de l’écran LCD (affichage de texte)
 #include "keypad.h"       // Gestion du clavier matriciel
 #include "push_button.h"  // Gestion du bouton physique
+#include "game_event.h"   // File d’événements et minuteries du jeu
+#include "puzzle.h"       // Énigmes (scénarios) simultanées
+#include "coop.h"         // Ordonnanceur coopératif
+#include "assets.h"       // Paquet de ressources projeté depuis la flash
+#include "secret.h"       // Vérification du code (mesure optionnelle)
+#include "analytics.h"    // Statistiques des parties (NVS)
+#include "test_io.h"      // Entrées de test (CONFIG_GAME_TEST_IO)
+#include "boot_prof.h"    // Chronologie du démarrage
+#include "init_graph.h"   // Initialisations concurrentes
+#include "power.h"        // Fréquence dynamique, sommeil léger
+#include "cpu_load.h"     // Charge par cœur (CONFIG_GAME_LOAD_REPORT_S)
+#include "heap_guard.h"   // Allocations après le démarrage (CONFIG_GAME_HEAP_GUARD)
+#include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"      // Journalisation pour le débogage (console série)
+#include "hal_time.h"     // Horodatage (latence entrée → réaction)
 
 // Tag de log, utilisé pour les messages ESP_LOGI
 static const char *TAG = "GAME_LOGIC";
 
+#define GAME_TASK_STACK 4096
+#define GAME_TASK_PRIO  5
+
 // ----------------------------------------------------------------------
-// Fonction principale du jeu
+// Sources d’événements : appelées par les pilotes
 // ----------------------------------------------------------------------
-void launch_game() {
-    // Initialisation de tous les périphériques
-    leds_init();       // Prépare les LED (EP1, erreur, etc.)
-    button_init();     // Configure le bouton poussoir
-    lcd_i2c_init();    // Initialise la communication I2C pour l’écran LCD
-    lcd_init();        // Initialise l’écran LCD
-    keypad_init();     // Prépare le clavier matriciel
+static void on_key(char key) {
+    game_event_post(GAME_SRC_KEYPAD, GAME_EVT_KEY, (uint8_t)key);
+}
 
-    // Message de confirmation dans le terminal série
-    ESP_LOGI(TAG, "Keypad prêt !");
+static bool on_button(int pressed) {
+    return game_event_post_from_isr(GAME_SRC_BUTTON, GAME_EVT_BUTTON, (uint8_t)pressed);
+}
+
+static void on_morse(char c) {
+    game_event_post(GAME_SRC_MORSE, GAME_EVT_MORSE, (uint8_t)c);
+}
 
-    // Récupération des pointeurs vers les LED spécifiques
-    Led *ep1 = get_led_ep1();  // LED de réussite (épisode 1)
-    Led *err = get_led_err();  // LED d’erreur
+// ----------------------------------------------------------------------
+// Charge les caractères personnalisés du paquet dans le LCD (après
+// l’invite, qui n’en utilise pas : ~40 ms de moins avant son affichage)
+// ----------------------------------------------------------------------
+static void load_glyphs(void) {
+    size_t size;
+    const uint8_t *glyphs = assets_find("glyphs", ASSET_GLYPHS, &size);
+    for (size_t i = 0; glyphs != NULL && i < size / 8; i++) {
+        lcd_create_char(i, &glyphs[i * 8]);
+    }
+}
 
-    // Variables pour le mot de passe et le contrôle du jeu
-    char password[6] = {0};  // Buffer du code entré (5 caractères + '\0')
-    int index = 0;           // Position d’écriture dans le mot de passe
-    int sentinelle = 0;      // Sert de condition de sortie de la boucle principale
+// ----------------------------------------------------------------------
+// Étapes du démarrage et leurs dépendances (init_graph.c) : les étapes
+// indépendantes tournent en même temps, par exemple LEDs, clavier et
+// ressources pendant les attentes de mise sous tension de l’écran.
+// Les caractères personnalisés ne sont chargés qu’après l’invite.
+// ----------------------------------------------------------------------
+static esp_err_t s_assets_err = ESP_FAIL;
 
-    // ------------------------------------------------------------------
-    // Boucle principale : tourne jusqu’à ce que le bon code soit entré
-    // ------------------------------------------------------------------
-    while (sentinelle == 0) {
+static void init_assets(void) {
+    s_assets_err = assets_load();
+}
 
-        // Vérifie si le bouton est pressé
-        int button_pressed = button_poll() == 1;
+static void init_inputs(void) {
+    // Les pilotes alimentent la file d’événements
+    keypad_start(on_key);
+    button_start(on_button);
+    button_morse_start(on_morse);    // Codes tapés en Morse au bouton
+#if CONFIG_GAME_TEST_IO
+    test_io_start();
+#endif
+}
 
-        // Affiche le message d’invite sur la première ligne du LCD
-        lcd_set_cursor(0, 0);
-        lcd_print("Entrez le code:");
+enum { STEP_LEDS, STEP_BUTTON, STEP_KEYPAD, STEP_I2C, STEP_LCD, STEP_EVENTS,
+       STEP_ANALYTICS, STEP_ASSETS, STEP_INPUTS, STEP_POWER, STEP_COUNT };
+
+static const init_step_t s_init_steps[STEP_COUNT] = {
+    [STEP_LEDS]      = {"leds",      leds_init,        0},  // Prépare les LED (EP1, erreur, etc.)
+    [STEP_BUTTON]    = {"button",    button_init,      0},  // Configure le bouton poussoir
+    [STEP_KEYPAD]    = {"keypad",    keypad_init,      0},  // Prépare le clavier matriciel
+    [STEP_I2C]       = {"i2c",       lcd_i2c_init,     0},  // Bus I2C de l’écran
+    [STEP_LCD]       = {"lcd",       lcd_init,         INIT_DEP(STEP_I2C)},
+    [STEP_EVENTS]    = {"events",    game_events_init, 0},  // File d’événements, journal
+    [STEP_ANALYTICS] = {"analytics", analytics_init,   0},  // Statistiques (NVS)
+    [STEP_ASSETS]    = {"assets",    init_assets,      0},  // Paquet de ressources
+    [STEP_INPUTS]    = {"inputs",    init_inputs,
+                        INIT_DEP(STEP_BUTTON) | INIT_DEP(STEP_KEYPAD) | INIT_DEP(STEP_EVENTS)},
+    [STEP_POWER]     = {"power",     power_start,      // Après les pilotes : démarrage à pleine vitesse
+                        INIT_DEP(STEP_INPUTS) | INIT_DEP(STEP_LCD) | INIT_DEP(STEP_LEDS) | INIT_DEP(STEP_ANALYTICS)},
+};
 
-        // Lecture d’une touche du clavier matriciel
-        char key = keypad_scan();
+// ----------------------------------------------------------------------
+// Tâche du jeu : démarre les énigmes puis reste bloquée sur la file
+// d’événements jusqu’à la fin de la dernière énigme
+// ----------------------------------------------------------------------
+static void game_task(void *arg) {
+#if CONFIG_GAME_SECRET_BENCH
+    secret_benchmark();
+#endif
+    coop_run(NULL);    // Démarrage des énigmes
+    lcd_render_sync(); // Invite réellement à l’écran
+    boot_prof_mark("invite");
+#if CONFIG_GAME_TEST_IO
+    test_io_report(NULL);
+#endif
+    load_glyphs();     // Déposés derrière l’invite, hors du bilan
+    boot_prof_report();
+    heap_guard_arm();
 
-        // Si le bouton est pressé, joue une séquence en Morse via les LED
-        if (button_pressed) {
-            leds_morse_sequence("b947d");
+    // ------------------------------------------------------------------
+    // Boucle principale : bloquée sur la file jusqu’au prochain événement,
+    // tourne tant qu’une énigme est en cours
+    // ------------------------------------------------------------------
+    while (coop_alive()) {
+        game_event_t ev;
+        if (!game_event_wait(&ev, portMAX_DELAY)) continue;
+        if (ev.type == GAME_EVT_KEY || ev.type == GAME_EVT_BUTTON) {
+            cpu_load_input(hal_time_us() - ev.t_us);
         }
 
-        // Si une touche a été détectée
-        if (key != '\0') {
-            password[index++] = key;  // Ajoute la touche au mot de passe
-            password[index] = '\0';   // Termine la chaîne proprement
-
-            lcd_clear();              // Efface l’écran
-            lcd_set_cursor(1, 0);     // Se place sur la 2ᵉ ligne
-            lcd_print(password);      // Affiche le code tapé
-
-            // Quand 5 caractères sont saisis
-            if (index >= 5) {
-                // Vérifie si le code est correct
-                if (strcmp(password, "B947D") == 0) {
-                    led_on(ep1);                          // Allume LED de réussite
-                    vTaskDelay(pdMS_TO_TICKS(500));
-                    lcd_set_cursor(0, 0);
-                    lcd_print("Reussite!");               // Message de succès
-                    lcd_set_cursor(1, 0);
-                    lcd_print("Wait for part 2!");        // Indique la suite
-                    vTaskDelay(pdMS_TO_TICKS(500));
-
-                    sentinelle = 1;                       // Sortie de la boucle
-                }
-                else {
-                    // Code incorrect → LED rouge + message d’erreur
-                    led_on(err);
-                    vTaskDelay(pdMS_TO_TICKS(500));
-                    lcd_set_cursor(0, 0);
-                    lcd_print("Nope!");
-                    vTaskDelay(pdMS_TO_TICKS(1000));
-                    led_off(err);                         // Éteint la LED erreur
-                    lcd_clear();                          // Réinitialise l’affichage
-                }
-                
-                // Réinitialise les variables pour une nouvelle tentative
-                vTaskDelay(pdMS_TO_TICKS(1000));
-                index = 0;
-            }
-        }
+        coop_run(&ev);
+#if CONFIG_GAME_TEST_IO
+        test_io_report(&ev);
+#endif
+        heap_guard_check();
+        ESP_LOGD(TAG, "Événement %d traité en %lld us", ev.type,
+                 (long long)(hal_time_us() - ev.t_us));
+    }
+    ESP_LOGI(TAG, "Plus aucune énigme en cours");
+    vTaskDelete(NULL);
+}
+
+// ----------------------------------------------------------------------
+// Fonction principale du jeu : initialise les périphériques (sur le cœur
+// de l’appelant, qui devient celui des entrées) puis lance la tâche du jeu
+// ----------------------------------------------------------------------
+void launch_game() {
+    // Pile et descripteur de la tâche du jeu, prêtés aux initialisations
+    static StackType_t stack[GAME_TASK_STACK];
+    static StaticTask_t tcb;
+
+    // Initialisation de tous les périphériques
+    init_graph_run(s_init_steps, STEP_COUNT, stack, GAME_TASK_STACK, &tcb);
+    boot_prof_mark("init");
 
-        // Petite pause pour ne pas surcharger le CPU
-        vTaskDelay(pdMS_TO_TICKS(100));
+    // Message de confirmation dans le terminal série
+    ESP_LOGI(TAG, "Keypad prêt !");
+
+    if (s_assets_err != ESP_OK || puzzles_start() == 0) {
+        lcd_print("Scenario absent");
+        return;
     }
+
+    // Répartition des tâches entre les cœurs
+#if CONFIG_GAME_DUAL_CORE
+    BaseType_t core_io = xPortGetCoreID();         // Celui des initialisations et des ISR
+    BaseType_t core_logic = 1 - core_io;           // Boucle du jeu (et réseau)
+#else
+    BaseType_t core_io = tskNO_AFFINITY, core_logic = tskNO_AFFINITY;
+#endif
+    lcd_render_start(core_io);
+    cpu_load_start();
+    xTaskCreateStaticPinnedToCore(game_task, "game", GAME_TASK_STACK, NULL, GAME_TASK_PRIO, stack, &tcb, core_logic);
 }
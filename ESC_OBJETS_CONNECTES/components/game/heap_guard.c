@@ -0,0 +1,117 @@
+// ======================================================================
+//  Module : heap_guard.c
+//  Description : Détection des allocations sur le tas après le démarrage
+//  Fonctionnement :
+//     - Les tâches, files, sémaphores et listes de commandes I2C sont
+//       alloués statiquement ; seules les initialisations (minuteries
+//       esp_timer, pilotes) utilisent le tas, avant que la garde ne soit
+//       armée.
+//     - CONFIG_HEAP_USE_HOOKS : ESP-IDF appelle
+//       esp_heap_trace_alloc_hook() à chaque allocation réussie. Une fois
+//       la garde armée, le crochet compte l’allocation et retient sa
+//       taille et la tâche appelante.
+//     - La boucle du jeu appelle heap_guard_check() après chaque
+//       événement : les allocations apparues depuis le dernier appel
+//       sont signalées, avec l’état du tas.
+//     - Exception : les écritures NVS de fin de partie. NVS (ESP-IDF)
+//       alloue à chaque écriture, même avec un handle ouvert au
+//       démarrage (nœuds de liste des blobs, blocs d’index des pages).
+//       Ces allocations sont comptées à part et résumées à la fin du
+//       lot avec le plus grand bloc libre : une fragmentation qui
+//       s’installe au fil des parties se voit dans ce relevé.
+// ======================================================================
+
+#include "heap_guard.h"
+#include "sdkconfig.h"
+
+#if CONFIG_GAME_HEAP_GUARD
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+static const char *TAG = "heap";
+
+static atomic_bool s_armed = false;
+static atomic_int s_exempt = 0;
+static atomic_uint s_exempt_count = 0;     // Allocations tolérées du lot en cours
+static atomic_uint s_count = 0;            // Allocations depuis l’armement
+static atomic_uint s_bytes = 0;
+static size_t s_last_size = 0;             // Dernière allocation comptée
+static TaskHandle_t s_last_task = NULL;    // NULL : depuis une ISR
+static unsigned s_reported = 0;            // Déjà signalées
+
+// ----------------------------------------------------------------------
+//  Crochets du tas (toutes les tâches, en IRAM)
+// ----------------------------------------------------------------------
+void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps) {
+    if (!atomic_load(&s_armed)) return;
+    if (atomic_load(&s_exempt) > 0) {
+        atomic_fetch_add(&s_exempt_count, 1);
+        return;
+    }
+    atomic_fetch_add(&s_count, 1);
+    atomic_fetch_add(&s_bytes, size);
+    s_last_size = size;
+    s_last_task = xPortInIsrContext() ? NULL : xTaskGetCurrentTaskHandle();
+}
+
+void IRAM_ATTR esp_heap_trace_free_hook(void *ptr) {
+}
+
+static void heap_guard_log_state(void) {
+    ESP_LOGI(TAG, "Tas libre %u octets (minimum %u, plus grand bloc %u)",
+             (unsigned)heap_caps_get_free_size(MALLOC_CAP_DEFAULT),
+             (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT),
+             (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT));
+}
+
+void heap_guard_arm(void) {
+    heap_guard_log_state();
+    atomic_store(&s_armed, true);
+    ESP_LOGI(TAG, "Garde armée : plus aucune allocation attendue");
+}
+
+void heap_guard_check(void) {
+    unsigned count = atomic_load(&s_count);
+    if (count == s_reported) return;
+
+    TaskHandle_t task = s_last_task;
+    ESP_LOGE(TAG, "%u allocation(s) après le démarrage (%u octets), dernière : %u octets, tâche %s",
+             count - s_reported, (unsigned)atomic_load(&s_bytes), (unsigned)s_last_size,
+             task != NULL ? pcTaskGetName(task) : "ISR");
+    s_reported = count;
+    heap_guard_log_state();
+#if CONFIG_GAME_HEAP_GUARD_ABORT
+    abort();
+#endif
+}
+
+void heap_guard_exempt(bool on) {
+    if (on) {
+        atomic_fetch_add(&s_exempt, 1);
+        return;
+    }
+    if (atomic_fetch_sub(&s_exempt, 1) != 1) return;
+    unsigned count = atomic_exchange(&s_exempt_count, 0);
+    if (count > 0) {
+        ESP_LOGI(TAG, "%u allocation(s) tolérée(s) (NVS), plus grand bloc libre %u octets", count,
+                 (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT));
+    }
+}
+
+#else
+
+void heap_guard_arm(void) {
+}
+
+void heap_guard_check(void) {
+}
+
+void heap_guard_exempt(bool on) {
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----------------------------------------------------------------------
+//  Statistiques des parties (espace NVS "stats")
+//
+//  "tot"       : cumuls et histogramme des temps de résolution
+//  "s00".."s3f": dernières parties, réécrites en boucle
+// ----------------------------------------------------------------------
+#define ANALYTICS_VERSION  1
+#define ANALYTICS_HISTORY  64         // Parties conservées en détail
+#define ANALYTICS_BUCKETS  32         // Demi-octaves à partir de 1 s
+
+// Mesures d’une partie en cours (RAM uniquement)
+typedef struct {
+    int64_t start_us;
+    uint16_t attempts;       // Codes complets saisis
+    uint16_t failures;       // Dont erronés
+    uint8_t hints;           // Indices affichés
+} analytics_session_t;
+
+// Partie terminée, telle qu’enregistrée
+typedef struct {
+    char puzzle[12];         // Nom de l’énigme (non terminé si 12 caractères)
+    uint32_t seq;            // Numéro de partie
+    uint32_t duration_ms;
+    uint16_t attempts;
+    uint16_t failures;
+    uint8_t hints;
+    uint8_t solved;
+    uint16_t reserved;
+} analytics_record_t;
+
+// Cumuls tenus à jour à chaque partie : lecture sans relire l’historique
+typedef struct {
+    uint32_t version;
+    uint32_t sessions;
+    uint32_t solved;
+    uint32_t attempts;
+    uint32_t failures;
+    uint32_t hints;
+    uint64_t solve_ms_sum;
+    uint32_t hist[ANALYTICS_BUCKETS];   // Parties résolues par temps de résolution
+} analytics_totals_t;
+
+void analytics_init(void);
+void analytics_begin(analytics_session_t *s);
+void analytics_attempt(analytics_session_t *s, bool ok);
+void analytics_hint(analytics_session_t *s);
+void analytics_end(const analytics_session_t *s, const char *puzzle, bool solved);
+
+const analytics_totals_t *analytics_totals(void);
+uint32_t analytics_percentile_ms(unsigned pct);
+bool analytics_history(uint32_t seq, analytics_record_t *rec);
+
+#endif
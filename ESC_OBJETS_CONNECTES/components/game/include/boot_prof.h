@@ -0,0 +1,17 @@
+#ifndef BOOT_PROF_H
+#define BOOT_PROF_H
+#include <stdint.h>
+
+// ----------------------------------------------------------------------
+//  Étapes du démarrage horodatées (hal_time_us, depuis le lancement de
+//  l’application ; le bootloader n’est pas compté)
+//  boot_prof_mark() peut être appelée depuis n’importe quelle tâche ;
+//  phase doit rester valide (chaîne littérale).
+// ----------------------------------------------------------------------
+#define BOOT_PROF_MAX 24
+
+void boot_prof_mark(const char *phase);
+void boot_prof_step(const char *phase, int64_t start_us, int64_t end_us);   // Étape concurrente
+void boot_prof_report(void);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+#include <stdint.h>
+
+// ----------------------------------------------------------------------
+//  Charge de chaque cœur et gigue des entrées (CONFIG_GAME_LOAD_REPORT_S)
+//  Toutes les N secondes (tag "load") : part du temps hors tâche inactive
+//  sur chaque cœur, puis médiane, p99 et maximum du délai entre une
+//  entrée (clavier, bouton) et sa prise en charge par la boucle du jeu.
+//  Sans l’option : fonctions vides.
+// ----------------------------------------------------------------------
+void cpu_load_start(void);
+void cpu_load_input(int64_t latency_us);   // Boucle du jeu uniquement
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef GAME_EVENT_H
+#define GAME_EVENT_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+
+// Types d’événements traités par la boucle du jeu
+typedef enum {
+    GAME_EVT_KEY,        // Touche du clavier (arg = caractère)
+    GAME_EVT_BUTTON,     // Bouton poussoir (arg = 1 appuyé, 0 relâché)
+    GAME_EVT_TIMER,      // Minuterie du jeu échue (arg = identifiant)
+    GAME_EVT_NET,        // Réservé : message réseau (arg = code)
+    GAME_EVT_MORSE,      // Caractère tapé en Morse au bouton (arg = caractère, ' ' entre mots)
+    GAME_EVT_COUNT
+} game_event_type_t;
+
+// Sources d’événements : une file sans verrou par source, dont la source
+// est le seul producteur (une seule tâche, ou une seule ISR)
+typedef enum {
+    GAME_SRC_KEYPAD,     // Tâche du clavier
+    GAME_SRC_BUTTON,     // ISR du bouton
+    GAME_SRC_CONSOLE,    // Entrées de test (test_io.c)
+    GAME_SRC_NET,        // Réservé : tâche réseau
+    GAME_SRC_MORSE,      // Minuterie du décodeur Morse (push_button.c)
+    GAME_SRC_COUNT
+} game_source_t;
+
+// Nombre maximal d’énigmes simultanées
+#define GAME_PUZZLE_MAX 4
+
+// Minuteries réservées à chaque énigme (délai d’état, chrono, indices, blocage)
+#define GAME_TIMERS_PER_PUZZLE 4
+
+// Minuteries du jeu (une seule échéance à la fois par identifiant)
+typedef enum {
+    GAME_TIMER_PUZZLE,   // + i × GAME_TIMERS_PER_PUZZLE : minuteries de l’énigme i
+    GAME_TIMER_COUNT = GAME_TIMER_PUZZLE + GAME_PUZZLE_MAX * GAME_TIMERS_PER_PUZZLE
+} game_timer_id_t;
+
+// Ressources partagées entre énigmes (arbitrées par coop.c)
+#define GAME_RES_LCD      (1u << 0)
+#define GAME_RES_KEYPAD   (1u << 1)
+#define GAME_RES_BUTTON   (1u << 2)
+#define GAME_RES_LED(m)   ((uint32_t)(m) << 3)   // m : masque LED_EP1 | LED_EP2 | LED_ERR
+
+typedef struct {
+    uint8_t type;        // game_event_type_t
+    uint8_t arg;
+    int64_t t_us;        // Horodatage de la source (esp_timer_get_time)
+} game_event_t;
+
+void game_events_init(void);
+bool game_event_post(game_source_t src, uint8_t type, uint8_t arg);
+bool game_event_post_from_isr(game_source_t src, uint8_t type, uint8_t arg);
+bool game_event_wait(game_event_t *ev, TickType_t timeout);
+void game_timer_start(game_timer_id_t id, uint32_t delay_ms);
+void game_timer_every(game_timer_id_t id, uint32_t period_ms);
+void game_timer_stop(game_timer_id_t id);
+
+#endif
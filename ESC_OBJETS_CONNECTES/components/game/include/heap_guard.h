@@ -0,0 +1,20 @@
+#ifndef HEAP_GUARD_H
+#define HEAP_GUARD_H
+#include <stdbool.h>
+
+// ----------------------------------------------------------------------
+//  Garde du tas après le démarrage (CONFIG_GAME_HEAP_GUARD)
+//  Une fois armée, toute allocation sur le tas est comptée ; la boucle du
+//  jeu signale les nouvelles (tag "heap") après chaque événement et
+//  arrête le programme si CONFIG_GAME_HEAP_GUARD_ABORT est activée.
+//  Sans l’option : fonctions vides.
+// ----------------------------------------------------------------------
+void heap_guard_arm(void);          // Fin du démarrage : bilan du tas
+void heap_guard_check(void);        // Boucle du jeu uniquement
+
+// Allocations tolérées entre exempt(true) et exempt(false), toutes
+// tâches confondues (écritures NVS, qui allouent toujours) ; leur
+// nombre et le plus grand bloc libre sont affichés à la fin du lot
+void heap_guard_exempt(bool on);
+
+#endif
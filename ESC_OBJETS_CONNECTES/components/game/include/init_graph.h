@@ -0,0 +1,29 @@
+#ifndef INIT_GRAPH_H
+#define INIT_GRAPH_H
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// ----------------------------------------------------------------------
+//  Initialisations concurrentes ordonnées par leurs dépendances
+//
+//  Chaque étape nomme les étapes qui doivent être terminées avant elle
+//  (masque INIT_DEP(i), i = rang dans le tableau). Les étapes prêtes
+//  tournent en même temps ; init_graph_run() rend la main quand toutes
+//  sont terminées. Durée de chaque étape : bilan "boot" (boot_prof.h).
+//  stack/tcb : pile (stack_size octets) et descripteur prêtés à la tâche
+//  qui exécute les étapes avec l’appelant, rendus au retour.
+// ----------------------------------------------------------------------
+#define INIT_GRAPH_MAX 24                 // Étapes au plus
+#define INIT_DEP(i)    (1u << (i))
+
+typedef struct {
+    const char *name;
+    void (*fn)(void);
+    uint32_t deps;
+} init_step_t;
+
+void init_graph_run(const init_step_t *steps, int count,
+                    StackType_t *stack, uint32_t stack_size, StaticTask_t *tcb);
+
+#endif
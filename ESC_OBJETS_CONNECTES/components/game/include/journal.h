@@ -0,0 +1,46 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "game_event.h"
+
+// ----------------------------------------------------------------------
+//  Format du journal (partition "journal", petit-boutiste)
+//  Doit rester identique à tools/journal_dump.py.
+//
+//  Secteurs de 4 Ko utilisés en boucle ; chacun commence par un en-tête.
+//  Enregistrement : [type][arg][délai depuis le précédent, varint µs].
+//  Un octet 0xFF à la place du type marque la fin des données du secteur.
+// ----------------------------------------------------------------------
+#define JOURNAL_MAGIC       0x314E524Au   // "JRN1"
+#define JOURNAL_SECTOR_SIZE 4096
+#define JOURNAL_RECORD_MAX  7             // 2 octets + varint de 5 octets au plus
+#define JOURNAL_END         0xFF
+
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;            // Numéro croissant du secteur
+    uint32_t session;        // seq du premier secteur de la session
+    uint32_t reserved;
+} journal_sector_t;
+
+// Lecture d’une session enregistrée
+typedef struct {
+    const uint8_t *log;      // Journal complet (partition projetée ou copie)
+    size_t sectors;
+    uint32_t session;
+    uint32_t seq;            // Secteur en cours de lecture
+    const uint8_t *p;
+    const uint8_t *end;
+    int64_t t_us;            // Horloge reconstruite (0 = début de session)
+} journal_reader_t;
+
+void journal_start(void);
+void journal_record(const game_event_t *ev);
+
+bool journal_reader_open(journal_reader_t *r, const void *log, size_t size);
+bool journal_reader_next(journal_reader_t *r, game_event_t *ev);
+const void *journal_map(size_t *size);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef POWER_H
+#define POWER_H
+
+// ----------------------------------------------------------------------
+//  Gestion d’énergie (CONFIG_PM_ENABLE, sans effet sur linux)
+//  Fréquence dynamique entre CONFIG_GAME_PM_MIN_FREQ_MHZ et la fréquence
+//  par défaut du processeur ; les pilotes tiennent des verrous
+//  (hal_pm.h) pendant leur travail sensible au temps.
+//  À lancer une fois les pilotes démarrés (réveil par le clavier).
+//  Avec CONFIG_GAME_PM_REPORT_S, le temps passé à chaque fréquence est
+//  affiché périodiquement (esp_pm_dump_locks).
+// ----------------------------------------------------------------------
+void power_start(void);
+
+#endif
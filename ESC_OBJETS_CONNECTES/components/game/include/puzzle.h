@@ -0,0 +1,23 @@
+#ifndef PUZZLE_H
+#define PUZZLE_H
+#include "coop.h"
+#include "scenario.h"
+#include "assets.h"
+
+// Événements gardés pendant qu’une énigme attend ses ressources
+#define PUZZLE_PENDING_MAX 4
+
+// Énigme : protothread + instance de scénario (aucune pile dédiée)
+typedef struct {
+    coop_task_t task;
+    scenario_t scn;
+    game_event_t pending[PUZZLE_PENDING_MAX];   // File des événements à traiter
+    uint8_t pending_first;
+    uint8_t pending_count;
+    uint32_t needs;          // Ressources de l’événement en tête de file
+    char name[ASSET_NAME_LEN + 1];
+} puzzle_t;
+
+int puzzles_start(void);
+
+#endif
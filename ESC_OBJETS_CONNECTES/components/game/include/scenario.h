@@ -0,0 +1,143 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "game_event.h"
+#include "secret.h"
+#include "input_line.h"
+#include "analytics.h"
+
+// ----------------------------------------------------------------------
+//  Format binaire d’un scénario (petit-boutiste, champs alignés)
+//  Doit rester identique à tools/scenario_pack.py.
+//
+//  [en-tête][états × state_count][transitions × state_count × SCN_EV_COUNT]
+//  [indices × hint_count][actions × action_count][secrets × secret_count]
+//  [chaînes terminées par '\0']
+// ----------------------------------------------------------------------
+#define SCN_MAGIC       0x314E4353u   // "SCN1"
+#define SCN_VERSION     4
+#define SCN_STATE_NONE  0xFF          // Événement ignoré dans cet état
+#define SCN_STATE_STAY  0xFE          // Actions seules, l’état ne change pas
+#define SCN_NO_COUNTDOWN 0xFF         // Pas d’affichage du temps restant
+#define SCN_TIME_MAX    5999          // 99:59, largeur fixe de l’affichage
+#define SCN_LOCKOUT_MAX_S 900         // Blocage le plus long après doublements
+#define SCN_CODE_MAX    INPUT_LINE_MAX  // Longueur maximale d’un code à saisir
+#define SCN_INPUT_MORSE 0x80          // Code tapé en Morse au bouton (validé une fois complet)
+#define SCN_INPUT_FLAGS (INPUT_LINE_MASKED | INPUT_LINE_AUTO_SUBMIT | SCN_INPUT_MORSE)
+
+// Entrées reconnues par la machine à états
+typedef enum {
+    SCN_EV_KEY,          // Touche (états sans saisie de code)
+    SCN_EV_BUTTON,       // Appui sur le bouton
+    SCN_EV_TIMEOUT,      // Délai de l’état écoulé
+    SCN_EV_CODE_OK,      // Code complet et correct
+    SCN_EV_CODE_BAD,     // Code complet et erroné
+    SCN_EV_NET,          // Message réseau (réservé)
+    SCN_EV_COUNT
+} scn_event_t;
+
+// Actions exécutables (a, b : opérandes)
+typedef enum {
+    SCN_OP_END,          // Fin du scénario
+    SCN_OP_LCD_CLEAR,    // Efface l’écran
+    SCN_OP_LCD_PRINT,    // a = ligne, b = chaîne
+    SCN_OP_LED_ON,       // a = masque de LED
+    SCN_OP_LED_OFF,      // a = masque de LED
+    SCN_OP_LED_EFFECT,   // a = LED (0 EP1, 1 EP2, 2 ERR), b = effet prédéfini
+    SCN_OP_MORSE,        // b = message joué sur la LED EP2
+    SCN_OP_TIMER,        // b = délai de l’état en ms, réarmé sans changer d’état (0 : arrêt)
+    SCN_OP_COUNT
+} scn_op_t;
+
+// Minuteries réservées par instance (à partir de scenario_t.timer)
+typedef enum {
+    SCN_TIMER_STATE,     // Délai de l’état courant
+    SCN_TIMER_CLOCK,     // Seconde du temps de partie
+    SCN_TIMER_HINT,      // Prochain indice
+    SCN_TIMER_LOCK,      // Fin du blocage de la saisie
+    SCN_TIMER_COUNT
+} scn_timer_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t state_count;
+    uint8_t initial;         // État de départ
+    uint16_t action_count;
+    uint16_t strings_size;
+    uint32_t size;           // Taille totale du scénario
+    uint16_t secret_count;
+    uint8_t hint_count;
+    uint8_t expired_state;   // État à la fin du temps (SCN_STATE_NONE : fin de partie)
+    uint16_t time_limit_s;   // Temps de partie, 0 = illimité
+    uint16_t lockout_s;      // Premier blocage de la saisie, doublé à chaque récidive
+    uint8_t lockout_failures;    // Échecs consécutifs avant blocage, 0 = jamais
+    uint8_t countdown_row;   // Position du temps restant "MM:SS" (SCN_NO_COUNTDOWN)
+    uint8_t countdown_col;
+    uint8_t reserved;
+} scn_header_t;
+
+typedef struct {
+    uint16_t enter_first;    // Actions exécutées à l’entrée
+    uint8_t enter_count;
+    uint8_t code_len;        // > 0 : l’état attend un code de cette longueur
+    uint16_t secret;         // Empreinte du code attendu (secret_t)
+    uint16_t timeout_ms;     // 0 = pas de délai
+    uint8_t input_flags;     // Options de la saisie (INPUT_LINE_MASKED, ..., SCN_INPUT_MORSE)
+    uint8_t reserved[3];
+} scn_state_t;
+
+typedef struct {
+    uint8_t target;          // État suivant, SCN_STATE_NONE ou SCN_STATE_STAY
+    uint8_t action_count;
+    uint16_t action_first;
+} scn_transition_t;
+
+// Indice déclenché après un temps de partie donné (triés par after_s)
+typedef struct {
+    uint16_t after_s;
+    uint16_t action_first;
+    uint8_t action_count;
+    uint8_t reserved;
+} scn_hint_t;
+
+typedef struct {
+    uint8_t op;
+    uint8_t a;
+    uint16_t b;
+} scn_action_t;
+
+// Instance d’un scénario : tables projetées en flash + état courant
+typedef struct {
+    const scn_header_t *hdr;
+    const scn_state_t *states;
+    const scn_transition_t *trans;
+    const scn_hint_t *hints;
+    const scn_action_t *actions;
+    const secret_t *secrets;
+    const char *strings;
+
+    uint8_t cur;             // État courant
+    uint8_t timer;           // Première des SCN_TIMER_COUNT minuteries réservées
+    bool done;
+    bool expired;            // Temps écoulé : partie non résolue
+    uint8_t failures;        // Échecs consécutifs
+    uint8_t lockouts;        // Blocages depuis le dernier code correct
+    uint16_t lock_s;         // Blocage restant (0 : saisie libre)
+    uint8_t next_hint;
+    uint16_t remaining_s;    // Temps de partie restant
+    input_line_t line;       // Code en cours de saisie
+    analytics_session_t stats;   // Mesures de la partie en cours
+} scenario_t;
+
+esp_err_t scenario_validate(const void *blob, size_t len);
+esp_err_t scenario_load(scenario_t *scn, const char *name, game_timer_id_t timer);
+void scenario_start(scenario_t *scn);
+bool scenario_dispatch(scenario_t *scn, const game_event_t *ev);
+uint32_t scenario_needs(const scenario_t *scn, const game_event_t *ev);
+uint32_t scenario_focus(const scenario_t *scn);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef SECRET_H
+#define SECRET_H
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define SECRET_SALT_LEN   16
+#define SECRET_DIGEST_LEN 32
+
+// Code secret stocké sous forme d’empreinte : SHA-256(sel || code)
+typedef struct {
+    uint8_t salt[SECRET_SALT_LEN];
+    uint8_t digest[SECRET_DIGEST_LEN];
+} secret_t;
+
+bool secret_verify(const secret_t *secret, const char *code, size_t len);
+void secret_benchmark(void);
+
+#endif
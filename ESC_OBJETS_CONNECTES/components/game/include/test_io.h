@@ -0,0 +1,20 @@
+#ifndef TEST_IO_H
+#define TEST_IO_H
+#include "game_event.h"
+
+// ----------------------------------------------------------------------
+//  Entrées et écran pilotés par la console (CONFIG_GAME_TEST_IO)
+//
+//  Commandes reçues (une par ligne) :
+//    key <touches>    une touche du clavier par caractère
+//    button <0|1>     bouton relâché / appuyé
+//    morse <texte>    caractères comme décodés au bouton (GAME_EVT_MORSE)
+//  Compte rendu après chaque modification de l’écran :
+//    TESTIO lcd t=<µs> lat=<µs> |<ligne 0>|<ligne 1>|
+//  t : horloge depuis le démarrage ; lat : délai depuis l’événement
+//  qui a provoqué l’affichage (-1 : démarrage).
+// ----------------------------------------------------------------------
+void test_io_start(void);
+void test_io_report(const game_event_t *ev);
+
+#endif
@@ -0,0 +1,130 @@
+// ======================================================================
+//  Module : init_graph.c
+//  Description : Exécution concurrente des initialisations
+//  Fonctionnement :
+//     - Deux exécutants prennent les étapes prêtes dans une file :
+//       l’appelant lui-même et une tâche à sa priorité et sur son cœur
+//       (les pilotes y laissent leurs ISR et leurs tâches). Seul l’écran
+//       attend longtemps (mise sous tension, séquence HD44780) : pendant
+//       ce temps, l’autre exécutant enchaîne les étapes indépendantes.
+//     - La tâche n’a pas de mémoire à elle : pile et descripteur sont
+//       prêtés par l’appelant (ceux d’une tâche lancée après le
+//       démarrage) et lui sont rendus, tâche supprimée, au retour.
+//     - Chaque étape terminée met en tête de file celles dont elle était
+//       la dernière dépendance : une chaîne comme i2c → lcd ne
+//       passe pas derrière les étapes indépendantes déjà en attente. La
+//       dernière étape envoie la fin du démarrage.
+//     - Une dépendance vers une étape placée plus loin dans le tableau
+//       est acceptée ; un cycle, qui bloquerait le démarrage, est
+//       refusé avant tout lancement.
+// ======================================================================
+
+#include <stdbool.h>
+#include "init_graph.h"
+#include "boot_prof.h"
+#include "hal_time.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+static const char *TAG = "init";
+
+#define INIT_RUNNERS 2                    // Appelant + une tâche
+#define INIT_STOP    (-1)                 // Fin du démarrage
+
+static const init_step_t *s_steps;
+static int s_count;
+static QueueHandle_t s_ready;             // Rang des étapes prêtes
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_queued = 0;             // Étapes mises en file
+static uint32_t s_done = 0;               // Étapes terminées
+
+// Marque finished terminée et met en file les étapes devenues prêtes ;
+// après la dernière, une fin par exécutant
+static void init_release(uint32_t finished) {
+    const uint32_t all = INIT_DEP(s_count) - 1;
+    uint32_t ready = 0;
+    bool last;
+
+    portENTER_CRITICAL(&s_mux);
+    s_done |= finished;
+    for (int i = 0; i < s_count; i++) {
+        if (!(s_queued & INIT_DEP(i)) && (s_steps[i].deps & ~s_done) == 0) ready |= INIT_DEP(i);
+    }
+    s_queued |= ready;
+    last = finished != 0 && s_done == all;
+    portEXIT_CRITICAL(&s_mux);
+
+    for (int i = 0; i < s_count; i++) {
+        if (!(ready & INIT_DEP(i))) continue;
+        if (finished) xQueueSendToFront(s_ready, &i, portMAX_DELAY);   // Suite d’une chaîne (i2c → lcd) d’abord
+        else xQueueSend(s_ready, &i, portMAX_DELAY);
+    }
+    if (last) {
+        const int stop = INIT_STOP;
+        for (int r = 0; r < INIT_RUNNERS; r++) xQueueSend(s_ready, &stop, portMAX_DELAY);
+    }
+}
+
+// Exécute les étapes prises dans la file jusqu’à la fin du démarrage
+static void init_run_steps(void) {
+    int i;
+    while (xQueueReceive(s_ready, &i, portMAX_DELAY) == pdTRUE && i != INIT_STOP) {
+        const init_step_t *step = &s_steps[i];
+        int64_t t0 = hal_time_us();
+        step->fn();
+        boot_prof_step(step->name, t0, hal_time_us());
+        init_release(INIT_DEP(i));
+    }
+}
+
+static void init_worker(void *arg) {
+    init_run_steps();
+    vTaskSuspend(NULL);                   // Supprimée par l’appelant
+}
+
+// Vrai si les dépendances forment un graphe sans cycle
+static bool init_graph_acyclic(const init_step_t *steps, int count) {
+    uint32_t placed = 0;
+    for (int round = 0; round < count; round++) {
+        bool progress = false;
+        for (int i = 0; i < count; i++) {
+            if (!(placed & INIT_DEP(i)) && (steps[i].deps & ~placed) == 0) {
+                placed |= INIT_DEP(i);
+                progress = true;
+            }
+        }
+        if (!progress) break;
+    }
+    return placed == INIT_DEP(count) - 1;
+}
+
+// Appelée une seule fois, depuis une tâche ; la pile prêtée (octets)
+// est libre au retour
+void init_graph_run(const init_step_t *steps, int count,
+                    StackType_t *stack, uint32_t stack_size, StaticTask_t *tcb) {
+    static int storage[INIT_GRAPH_MAX + INIT_RUNNERS];
+    static StaticQueue_t queue;
+
+    if (count > INIT_GRAPH_MAX || !init_graph_acyclic(steps, count)) {
+        ESP_LOGE(TAG, "Graphe d’initialisation invalide (%d étapes)", count);
+        ESP_ERROR_CHECK(ESP_ERR_INVALID_ARG);
+    }
+    if (count == 0) return;
+
+    s_steps = steps;
+    s_count = count;
+    s_ready = xQueueCreateStatic(INIT_GRAPH_MAX + INIT_RUNNERS, sizeof(int), (uint8_t *)storage, &queue);
+    TaskHandle_t worker = xTaskCreateStaticPinnedToCore(init_worker, "init", stack_size, NULL,
+                                                        uxTaskPriorityGet(NULL), stack, tcb, xPortGetCoreID());
+
+    init_release(0);                      // Étapes sans dépendance
+    init_run_steps();
+
+    // Sur le cœur de l’appelant et hors de toute étape : suppression
+    // immédiate, pile et descripteur réutilisables dès le retour
+    ESP_LOGD(TAG, "Pile prêtée : %u octets jamais utilisés", (unsigned)uxTaskGetStackHighWaterMark(worker));
+    vTaskDelete(worker);
+}
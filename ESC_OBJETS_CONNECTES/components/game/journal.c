@@ -0,0 +1,286 @@
+// ======================================================================
+//  Module : journal.c
+//  Description : Enregistrement des entrées du joueur et relecture
+//  Fonctionnement :
+//     - Chaque événement consommé par la boucle du jeu (touche, bouton,
+//       minuterie) est codé sur 3 à 7 octets dans un tampon circulaire
+//       en RAM, avec son délai en microsecondes depuis le précédent.
+//     - Une tâche de faible priorité vide le tampon dans la partition
+//       "journal" toutes les 5 s, ou plus tôt s’il est à moitié plein.
+//     - La partition est un anneau de secteurs numérotés : chaque
+//       démarrage ouvre une nouvelle session, les plus anciennes sont
+//       écrasées en premier.
+//     - Le lecteur reconstitue la dernière session complète à partir
+//       d’une copie du journal (partition projetée, ou fichier sur hôte).
+// ======================================================================
+
+#include "journal.h"
+#include "esp_partition.h"
+#include "hal_time.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "journal";
+
+// Type de la partition "journal" (plage réservée aux applications)
+#define JOURNAL_PARTITION_SUBTYPE 0x41
+
+#define JOURNAL_RING_SIZE   1024       // Tampon RAM (≈ 250 événements)
+#define JOURNAL_SPILL_MS    5000       // Période de vidage vers la flash
+#define JOURNAL_CHUNK       128        // Octets écrits par passage
+
+static const esp_partition_t *s_part = NULL;
+static size_t s_sectors;
+
+// Tampon circulaire : s_head et s_tail croissent sans borne (modulo à l’accès)
+static uint8_t s_ring[JOURNAL_RING_SIZE];
+static size_t s_head = 0;
+static size_t s_tail = 0;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static int64_t s_last_us;
+static uint32_t s_dropped = 0;
+static TaskHandle_t s_task = NULL;
+
+// Position d’écriture en flash
+static size_t s_sector;
+static size_t s_fill;
+static uint32_t s_seq;
+static uint32_t s_session;
+
+// ----------------------------------------------------------------------
+//  Longueur d’un enregistrement (JOURNAL_RECORD_MAX + 1 si incomplet)
+// ----------------------------------------------------------------------
+static size_t record_len(const uint8_t *p, size_t avail) {
+    size_t len = 2;
+    while (len < avail && len < JOURNAL_RECORD_MAX && (p[len] & 0x80)) len++;
+    len++;                                     // Dernier octet du varint
+    return len <= avail ? len : JOURNAL_RECORD_MAX + 1;
+}
+
+// ----------------------------------------------------------------------
+//  Efface un secteur et y écrit son en-tête
+// ----------------------------------------------------------------------
+static void sector_open(size_t idx, uint32_t seq) {
+    journal_sector_t h = {
+        .magic = JOURNAL_MAGIC,
+        .seq = seq,
+        .session = s_session,
+        .reserved = UINT32_MAX,
+    };
+    ESP_ERROR_CHECK(esp_partition_erase_range(s_part, idx * JOURNAL_SECTOR_SIZE, JOURNAL_SECTOR_SIZE));
+    ESP_ERROR_CHECK(esp_partition_write(s_part, idx * JOURNAL_SECTOR_SIZE, &h, sizeof(h)));
+    s_sector = idx;
+    s_seq = seq;
+    s_fill = sizeof(h);
+}
+
+// ----------------------------------------------------------------------
+//  Écrit des enregistrements complets ; aucun ne chevauche deux secteurs
+// ----------------------------------------------------------------------
+static void journal_write(const uint8_t *buf, size_t n) {
+    size_t i = 0;
+    while (i < n) {
+        size_t run = 0;
+        while (i + run < n) {
+            size_t len = record_len(&buf[i + run], n - i - run);
+            if (s_fill + run + len > JOURNAL_SECTOR_SIZE) break;
+            run += len;
+        }
+        if (run == 0) {                        // Secteur plein : le reste reste à 0xFF
+            sector_open((s_sector + 1) % s_sectors, s_seq + 1);
+            continue;
+        }
+        ESP_ERROR_CHECK(esp_partition_write(s_part, s_sector * JOURNAL_SECTOR_SIZE + s_fill, &buf[i], run));
+        s_fill += run;
+        i += run;
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Retire du tampon le plus d’enregistrements complets possible
+// ----------------------------------------------------------------------
+static size_t ring_take(uint8_t *buf, size_t max) {
+    portENTER_CRITICAL(&s_lock);
+    size_t n = s_head - s_tail;
+    if (n > max) n = max;
+    for (size_t i = 0; i < n; i++) buf[i] = s_ring[(s_tail + i) % JOURNAL_RING_SIZE];
+
+    size_t whole = 0;                          // Jamais de moitié d’enregistrement
+    while (whole < n) {
+        size_t len = record_len(&buf[whole], n - whole);
+        if (whole + len > n) break;
+        whole += len;
+    }
+    s_tail += whole;
+    portEXIT_CRITICAL(&s_lock);
+    return whole;
+}
+
+// ----------------------------------------------------------------------
+//  Tâche de vidage vers la flash
+// ----------------------------------------------------------------------
+static void journal_task(void *arg) {
+    uint8_t buf[JOURNAL_CHUNK];
+    uint32_t reported = 0;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(JOURNAL_SPILL_MS));
+        size_t n;
+        while ((n = ring_take(buf, sizeof(buf))) > 0) journal_write(buf, n);
+
+        if (s_dropped != reported) {
+            ESP_LOGW(TAG, "%lu événement(s) perdu(s), tampon plein", (unsigned long)(s_dropped - reported));
+            reported = s_dropped;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Ouvre une nouvelle session après la plus récente
+// ----------------------------------------------------------------------
+void journal_start(void) {
+    s_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, JOURNAL_PARTITION_SUBTYPE, "journal");
+    if (s_part == NULL) {
+        ESP_LOGW(TAG, "Partition \"journal\" absente, enregistrement désactivé");
+        return;
+    }
+    s_sectors = s_part->size / JOURNAL_SECTOR_SIZE;
+
+    // Secteur le plus récent
+    size_t last = s_sectors - 1;
+    uint32_t seq = 0;
+    for (size_t i = 0; i < s_sectors; i++) {
+        journal_sector_t h;
+        if (esp_partition_read(s_part, i * JOURNAL_SECTOR_SIZE, &h, sizeof(h)) != ESP_OK) continue;
+        if (h.magic == JOURNAL_MAGIC && h.seq + 1 > seq) {
+            seq = h.seq + 1;
+            last = i;
+        }
+    }
+
+    s_session = seq;
+    sector_open((last + 1) % s_sectors, seq);
+    s_last_us = hal_time_us();
+    static StackType_t stack[3072];
+    static StaticTask_t tcb;
+    s_task = xTaskCreateStatic(journal_task, "journal", sizeof(stack), NULL, 2, stack, &tcb);
+    ESP_LOGI(TAG, "Session %lu", (unsigned long)s_session);
+}
+
+// ----------------------------------------------------------------------
+//  Ajoute un événement au tampon (tâche du jeu)
+// ----------------------------------------------------------------------
+void journal_record(const game_event_t *ev) {
+    if (s_task == NULL) return;
+
+    uint8_t rec[JOURNAL_RECORD_MAX];
+    size_t n = 0;
+    int64_t dt = ev->t_us - s_last_us;
+    uint32_t d = dt < 0 ? 0 : (dt > UINT32_MAX ? UINT32_MAX : (uint32_t)dt);
+    s_last_us = ev->t_us;
+
+    rec[n++] = ev->type;
+    rec[n++] = ev->arg;
+    do {
+        rec[n++] = (d & 0x7F) | (d > 0x7F ? 0x80 : 0);   // Varint : 7 bits par octet
+        d >>= 7;
+    } while (d);
+
+    portENTER_CRITICAL(&s_lock);
+    size_t used = s_head - s_tail;
+    if (used + n <= JOURNAL_RING_SIZE) {
+        for (size_t i = 0; i < n; i++) s_ring[(s_head + i) % JOURNAL_RING_SIZE] = rec[i];
+        s_head += n;
+        used += n;
+    } else {
+        s_dropped++;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (used >= JOURNAL_RING_SIZE / 2) xTaskNotifyGive(s_task);
+}
+
+// ----------------------------------------------------------------------
+//  Projection du journal en lecture (relecture sur la carte)
+// ----------------------------------------------------------------------
+const void *journal_map(size_t *size) {
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           JOURNAL_PARTITION_SUBTYPE, "journal");
+    if (part == NULL) return NULL;
+
+    const void *log;
+    esp_partition_mmap_handle_t handle;
+    if (esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &log, &handle) != ESP_OK) {
+        return NULL;
+    }
+    *size = part->size;
+    return log;
+}
+
+// ----------------------------------------------------------------------
+//  Lecture : positionne le lecteur sur le secteur r->seq de la session
+// ----------------------------------------------------------------------
+static bool reader_seek(journal_reader_t *r) {
+    for (size_t i = 0; i < r->sectors; i++) {
+        const uint8_t *base = r->log + i * JOURNAL_SECTOR_SIZE;
+        const journal_sector_t *h = (const void *)base;
+        if (h->magic == JOURNAL_MAGIC && h->session == r->session && h->seq == r->seq) {
+            r->p = base + sizeof(*h);
+            r->end = base + JOURNAL_SECTOR_SIZE;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------
+//  Ouvre la session la plus récente du journal
+// ----------------------------------------------------------------------
+bool journal_reader_open(journal_reader_t *r, const void *log, size_t size) {
+    r->log = log;
+    r->sectors = size / JOURNAL_SECTOR_SIZE;
+    r->t_us = 0;
+
+    bool found = false;
+    for (size_t i = 0; i < r->sectors; i++) {
+        const journal_sector_t *h = (const void *)(r->log + i * JOURNAL_SECTOR_SIZE);
+        if (h->magic != JOURNAL_MAGIC) continue;
+        if (!found || h->session > r->session) {
+            r->session = h->session;
+            r->seq = h->seq;
+            found = true;
+        } else if (h->session == r->session && h->seq < r->seq) {
+            r->seq = h->seq;                   // Début de session encore présent
+        }
+    }
+    return found && reader_seek(r);
+}
+
+// ----------------------------------------------------------------------
+//  Événement suivant de la session (false : fin)
+//  ev->t_us = temps depuis le début de la session.
+// ----------------------------------------------------------------------
+bool journal_reader_next(journal_reader_t *r, game_event_t *ev) {
+    for (;;) {
+        if (r->end - r->p < 3 || r->p[0] == JOURNAL_END) {
+            r->seq++;                          // Secteur suivant de la session
+            if (!reader_seek(r)) return false;
+            continue;
+        }
+
+        size_t len = record_len(r->p, r->end - r->p);
+        if (len > JOURNAL_RECORD_MAX) return false;   // Enregistrement tronqué
+
+        uint32_t d = 0;
+        for (size_t i = len; i-- > 2;) d = (d << 7) | (r->p[i] & 0x7F);
+        r->t_us += d;
+
+        ev->type = r->p[0];
+        ev->arg = r->p[1];
+        ev->t_us = r->t_us;
+        r->p += len;
+        return true;
+    }
+}
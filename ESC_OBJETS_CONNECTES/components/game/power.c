@@ -0,0 +1,74 @@
+// ======================================================================
+//  Module : power.c
+//  Description : Fréquence dynamique, sommeil léger et mesure du temps
+//                passé à chaque fréquence
+//  Fonctionnement :
+//     - esp_pm_configure() : le processeur tourne à sa fréquence par
+//       défaut tant qu’un verrou CPU_MAX est tenu, le bus APB à 80 MHz
+//       tant qu’un verrou APB_MAX l’est ; sinon tout descend à
+//       CONFIG_GAME_PM_MIN_FREQ_MHZ. Les verrous sont pris par les
+//       pilotes (écran, LEDs, clavier) et par ceux d’ESP-IDF.
+//     - CONFIG_GAME_PM_LIGHT_SLEEP : la tâche inactive endort la puce
+//       (FreeRTOS sans tick) jusqu’à la prochaine échéance ou un appui
+//       sur le clavier.
+//     - CONFIG_GAME_PM_REPORT_S (profil sdkconfig.pm) : une tâche de
+//       faible priorité affiche toutes les N secondes le temps cumulé
+//       dans chaque mode (CPU_MAX, APB_MAX, APB_MIN, sommeil) et la
+//       durée de prise de chaque verrou.
+// ======================================================================
+
+#include "power.h"
+#include "sdkconfig.h"
+
+#if CONFIG_PM_ENABLE
+#include "keypad.h"
+#include "esp_pm.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+
+static const char *TAG = "power";
+
+#if CONFIG_GAME_PM_REPORT_S
+// ----------------------------------------------------------------------
+//  Mode mesure : temps cumulé par fréquence depuis le démarrage
+// ----------------------------------------------------------------------
+static void power_report_task(void *arg) {
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_GAME_PM_REPORT_S * 1000));
+        printf("---- power : temps par fréquence ----\n");
+        esp_pm_dump_locks(stdout);
+    }
+}
+#endif
+
+void power_start(void) {
+    const esp_pm_config_t config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = CONFIG_GAME_PM_MIN_FREQ_MHZ,
+#if CONFIG_GAME_PM_LIGHT_SLEEP
+        .light_sleep_enable = true,
+#endif
+    };
+    ESP_ERROR_CHECK(esp_pm_configure(&config));
+
+#if CONFIG_GAME_PM_LIGHT_SLEEP
+    keypad_wakeup_enable();
+#endif
+#if CONFIG_GAME_PM_REPORT_S
+    static StackType_t stack[3072];
+    static StaticTask_t tcb;
+    xTaskCreateStatic(power_report_task, "power", sizeof(stack), NULL, 1, stack, &tcb);
+#endif
+    ESP_LOGI(TAG, "Fréquence dynamique %d-%d MHz%s", CONFIG_GAME_PM_MIN_FREQ_MHZ,
+             CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+             config.light_sleep_enable ? ", sommeil léger" : "");
+}
+
+#else
+
+void power_start(void) {
+}
+
+#endif
@@ -0,0 +1,111 @@
+// ======================================================================
+//  Module : puzzle.c
+//  Description : Énigmes simultanées sur une seule tâche FreeRTOS
+//  Fonctionnement :
+//     - Chaque scénario du paquet de ressources devient une énigme :
+//       un protothread (coop.c) qui pilote sa propre instance de scénario.
+//     - Les ressources partagées (écran, clavier, bouton, LEDs) sont
+//       prises étape par étape : avant chaque événement, l’énigme obtient
+//       d’un coup celles qu’il touchera (scenario_needs), puis ne garde
+//       que le focus de son nouvel état (scenario_focus) : clavier ou
+//       bouton tant qu’elle attend une entrée, écran pendant la saisie
+//       d’un code. Deux énigmes alternent donc sur l’écran et le clavier,
+//       invite par invite, au lieu de s’enchaîner.
+//     - Une énigme qui doit attendre libère d’abord tout ce qu’elle
+//       détient (pas d’interblocage) ; ses événements sont gardés dans
+//       une petite file et traités dans l’ordre une fois servie.
+//     - Les touches ne vont qu’au détenteur du clavier, les appuis et le
+//       Morse décodé qu’au détenteur du bouton ; chaque énigme a sa
+//       propre minuterie.
+// ======================================================================
+
+#include "puzzle.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "puzzle";
+
+static puzzle_t s_puzzles[GAME_PUZZLE_MAX];
+
+// ----------------------------------------------------------------------
+//  L’événement concerne-t-il cette énigme ?
+// ----------------------------------------------------------------------
+static bool puzzle_accepts(const puzzle_t *p, const game_event_t *ev) {
+    switch (ev->type) {
+    case GAME_EVT_KEY:    return p->task.owned & GAME_RES_KEYPAD;
+    case GAME_EVT_BUTTON:
+    case GAME_EVT_MORSE:  return p->task.owned & GAME_RES_BUTTON;
+    case GAME_EVT_TIMER:  return (uint8_t)(ev->arg - p->scn.timer) < SCN_TIMER_COUNT;
+    default:              return true;
+    }
+}
+
+// File des événements à traiter
+static void puzzle_push(puzzle_t *p, const game_event_t *ev) {
+    if (p->pending_count == PUZZLE_PENDING_MAX) {
+        ESP_LOGW(TAG, "%s : file pleine, événement %d perdu", p->name, ev->type);
+        return;
+    }
+    p->pending[(p->pending_first + p->pending_count++) % PUZZLE_PENDING_MAX] = *ev;
+}
+
+static void puzzle_pop(puzzle_t *p) {
+    p->pending_first = (p->pending_first + 1) % PUZZLE_PENDING_MAX;
+    p->pending_count--;
+}
+
+// ----------------------------------------------------------------------
+//  Corps d’une énigme (protothread)
+// ----------------------------------------------------------------------
+static int puzzle_thread(coop_task_t *task, const void *msg) {
+    puzzle_t *p = task->ctx;
+    const game_event_t *ev = msg;
+
+    if (ev != NULL && !p->scn.done && puzzle_accepts(p, ev)) puzzle_push(p, ev);
+
+    PT_BEGIN(&task->pt);
+
+    PT_ACQUIRE(&task->pt, task, scenario_needs(&p->scn, NULL));
+    ESP_LOGI(TAG, "%s : démarrage", p->name);
+    scenario_start(&p->scn);
+    coop_release(task, task->owned & ~scenario_focus(&p->scn));
+
+    while (!p->scn.done) {
+        PT_WAIT_UNTIL(&task->pt, p->pending_count > 0);             // Événement suivant
+        p->needs = scenario_needs(&p->scn, &p->pending[p->pending_first]);
+        if (!coop_acquire(task, p->needs)) {
+            coop_release(task, task->owned);                        // Attente les mains vides
+            PT_ACQUIRE(&task->pt, task, p->needs);
+        }
+        scenario_dispatch(&p->scn, &p->pending[p->pending_first]);
+        puzzle_pop(p);
+        coop_release(task, task->owned & ~scenario_focus(&p->scn));
+    }
+    ESP_LOGI(TAG, "%s : terminée", p->name);
+    analytics_end(&p->scn.stats, p->name, !p->scn.expired);
+
+    PT_END(&task->pt);                                         // Ressources libérées
+}
+
+// ----------------------------------------------------------------------
+//  Crée une énigme par scénario du paquet
+//  Retourne le nombre d’énigmes prêtes (démarrage au prochain coop_run).
+// ----------------------------------------------------------------------
+int puzzles_start(void) {
+    int n = 0;
+
+    for (int i = 0; i < assets_count() && n < GAME_PUZZLE_MAX; i++) {
+        const asset_entry_t *e = assets_entry(i);
+        if (e->type != ASSET_SCENARIO) continue;
+
+        puzzle_t *p = &s_puzzles[n];
+        memcpy(p->name, e->name, ASSET_NAME_LEN);
+        p->name[ASSET_NAME_LEN] = '\0';
+        if (scenario_load(&p->scn, p->name, GAME_TIMER_PUZZLE + n * GAME_TIMERS_PER_PUZZLE) != ESP_OK) continue;
+
+        coop_add(&p->task, p->name, puzzle_thread, p);
+        n++;
+    }
+    ESP_LOGI(TAG, "%d énigme(s), %u octets de RAM chacune", n, (unsigned)sizeof(puzzle_t));
+    return n;
+}
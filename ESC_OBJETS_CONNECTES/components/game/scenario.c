@@ -0,0 +1,507 @@
+// ======================================================================
+//  Module : scenario.c
+//  Description : Moteur de scénario piloté par table
+//  Fonctionnement :
+//     - Le scénario (états, transitions, actions, textes) est compilé sur
+//       l’hôte par tools/scenario_pack.py et livré dans le paquet de
+//       ressources (assets.c) : il est lu directement en flash, sans copie.
+//     - Tout le contenu est vérifié une seule fois au chargement
+//       (indices, bornes, chaînes) : l’interprète ne refait aucun contrôle.
+//     - Transition = une lecture dans un tableau dense
+//       [état][événement] : coût constant, quel que soit le scénario.
+//     - Chaque instance (scenario_t) a son propre état et sa minuterie :
+//       plusieurs énigmes peuvent tourner en même temps (puzzle.c).
+//       scenario_needs() donne les ressources partagées que touchera un
+//       événement, scenario_focus() celles que l’état garde en attendant
+//       une entrée.
+//     - Un état peut attendre un code : les touches, ou les caractères
+//       tapés en Morse au bouton (SCN_INPUT_MORSE), passent par une
+//       ligne de saisie (input_line.c, effacement et validation), puis
+//       CODE_OK ou CODE_BAD est déclenché. Le code attendu n’existe que
+//       sous forme d’empreinte salée (secret.c).
+//     - Temps de partie : compte à rebours affiché pendant la saisie,
+//       indices programmés et blocage après des échecs répétés. Tous
+//       sont des échéances du tas de game_event.c, sans tâche ajoutée.
+//     - Le blocage double à chaque récidive (jusqu’à 15 min) mais ne
+//       suspend rien : le clavier reste lu et le temps restant s’affiche
+//       à la place du code, LEDs et autres énigmes continuent.
+// ======================================================================
+
+#include "scenario.h"
+#include "led.h"
+#include "led_effects.h"
+#include "lcd.h"
+#include "esp_log.h"
+#include "input_line.h"
+#include "assets.h"
+#include <stdio.h>
+
+static const char *TAG = "scenario";
+
+// Effets utilisables par SCN_OP_LED_EFFECT
+static const led_effect_t *const s_effects[] = {
+    &LED_EFFECT_BREATHE,
+    &LED_EFFECT_PULSE,
+    &LED_EFFECT_SUCCESS,
+    &LED_EFFECT_ERROR,
+};
+#define SCN_EFFECT_COUNT (sizeof(s_effects) / sizeof(s_effects[0]))
+#define SCN_LED_COUNT    3
+#define SCN_COUNTDOWN_LEN 5           // "MM:SS"
+#define SCN_LOCK_FMT     "Pause %3us"  // Affiché à la place du code pendant un blocage
+#define SCN_LOCK_LEN     10
+
+_Static_assert(SCN_TIMER_COUNT <= GAME_TIMERS_PER_PUZZLE, "Minuteries par énigme insuffisantes");
+
+// ----------------------------------------------------------------------
+//  Validation
+// ----------------------------------------------------------------------
+static bool string_ok(const scn_header_t *h, uint16_t off) {
+    return off < h->strings_size;     // Le bloc se termine par '\0'
+}
+
+static bool actions_ok(const scn_header_t *h, const scn_action_t *actions,
+                       uint16_t first, uint8_t count) {
+    if ((uint32_t)first + count > h->action_count) return false;
+
+    for (int i = first; i < first + count; i++) {
+        const scn_action_t *a = &actions[i];
+        switch (a->op) {
+        case SCN_OP_END:
+        case SCN_OP_LCD_CLEAR:
+            break;
+        case SCN_OP_LCD_PRINT:
+            if (a->a > 1 || !string_ok(h, a->b)) return false;
+            break;
+        case SCN_OP_LED_ON:
+        case SCN_OP_LED_OFF:
+            if (a->a & ~LED_ALL) return false;
+            break;
+        case SCN_OP_LED_EFFECT:
+            if (a->a >= SCN_LED_COUNT || a->b >= SCN_EFFECT_COUNT) return false;
+            break;
+        case SCN_OP_MORSE:
+            if (!string_ok(h, a->b)) return false;
+            break;
+        case SCN_OP_TIMER:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+esp_err_t scenario_validate(const void *blob, size_t len) {
+    const scn_header_t *h = blob;
+    if (len < sizeof(*h) || h->magic != SCN_MAGIC) return ESP_ERR_NOT_FOUND;
+    if (h->version != SCN_VERSION) return ESP_ERR_NOT_SUPPORTED;
+
+    size_t n_states = h->state_count;
+    size_t expected = sizeof(*h)
+                    + n_states * sizeof(scn_state_t)
+                    + n_states * SCN_EV_COUNT * sizeof(scn_transition_t)
+                    + h->hint_count * sizeof(scn_hint_t)
+                    + h->action_count * sizeof(scn_action_t)
+                    + h->secret_count * sizeof(secret_t)
+                    + h->strings_size;
+    if (n_states == 0 || h->initial >= n_states || h->size != expected || h->size > len) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    const scn_state_t *states = (const void *)(h + 1);
+    const scn_transition_t *trans = (const void *)(states + n_states);
+    const scn_hint_t *hints = (const void *)(trans + n_states * SCN_EV_COUNT);
+    const scn_action_t *actions = (const void *)(hints + h->hint_count);
+    const secret_t *secrets = (const void *)(actions + h->action_count);
+    const char *strings = (const void *)(secrets + h->secret_count);
+    if (h->strings_size == 0 || strings[h->strings_size - 1] != '\0') return ESP_ERR_INVALID_ARG;
+
+    for (size_t i = 0; i < n_states; i++) {
+        const scn_state_t *st = &states[i];
+        if (!actions_ok(h, actions, st->enter_first, st->enter_count)) return ESP_ERR_INVALID_ARG;
+        if (st->code_len > SCN_CODE_MAX || (st->input_flags & ~SCN_INPUT_FLAGS)) return ESP_ERR_INVALID_ARG;
+        if (st->code_len && st->secret >= h->secret_count) return ESP_ERR_INVALID_ARG;
+        if ((st->input_flags & SCN_INPUT_MORSE) && !(st->input_flags & INPUT_LINE_AUTO_SUBMIT)) {
+            return ESP_ERR_INVALID_ARG;       // Pas de touche '#' en Morse
+        }
+    }
+    for (size_t i = 0; i < n_states * SCN_EV_COUNT; i++) {
+        const scn_transition_t *t = &trans[i];
+        if (t->target >= n_states && t->target != SCN_STATE_NONE && t->target != SCN_STATE_STAY) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (!actions_ok(h, actions, t->action_first, t->action_count)) return ESP_ERR_INVALID_ARG;
+    }
+
+    // Temps de partie
+    if (h->time_limit_s > SCN_TIME_MAX) return ESP_ERR_INVALID_ARG;
+    if (h->expired_state >= n_states && h->expired_state != SCN_STATE_NONE) return ESP_ERR_INVALID_ARG;
+    if (h->countdown_row != SCN_NO_COUNTDOWN &&
+        (h->countdown_row > 1 || h->countdown_col > 16 - SCN_COUNTDOWN_LEN)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (h->lockout_failures && (h->lockout_s == 0 || h->lockout_s > SCN_LOCKOUT_MAX_S)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < h->hint_count; i++) {
+        if (i > 0 && hints[i].after_s < hints[i - 1].after_s) return ESP_ERR_INVALID_ARG;
+        if (!actions_ok(h, actions, hints[i].action_first, hints[i].action_count)) return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+// ----------------------------------------------------------------------
+//  Ressources partagées (GAME_RES_*)
+//  Une suite d’actions n’en a besoin que le temps de s’exécuter ; un
+//  état les garde tant qu’il attend une entrée (focus) : clavier ou
+//  bouton, et l’écran pendant la saisie d’un code (écho, temps restant).
+// ----------------------------------------------------------------------
+static uint32_t scn_actions_res(const scenario_t *scn, uint16_t first, uint8_t count) {
+    uint32_t res = 0;
+
+    for (const scn_action_t *a = &scn->actions[first]; count--; a++) {
+        switch (a->op) {
+        case SCN_OP_LCD_CLEAR:
+        case SCN_OP_LCD_PRINT:  res |= GAME_RES_LCD; break;
+        case SCN_OP_LED_ON:
+        case SCN_OP_LED_OFF:    res |= GAME_RES_LED(a->a); break;
+        case SCN_OP_LED_EFFECT: res |= GAME_RES_LED(1u << a->a); break;
+        case SCN_OP_MORSE:      res |= GAME_RES_LED(LED_EP2); break;
+        }
+    }
+    return res;
+}
+
+static uint32_t scn_state_focus(const scenario_t *scn, uint8_t state) {
+    const scn_state_t *st = &scn->states[state];
+    const scn_transition_t *t = &scn->trans[state * SCN_EV_COUNT];
+    uint32_t res = 0;
+
+    if (st->code_len) {                       // Saisie + écho
+        res |= GAME_RES_LCD | ((st->input_flags & SCN_INPUT_MORSE) ? GAME_RES_BUTTON : GAME_RES_KEYPAD);
+    }
+    if (t[SCN_EV_KEY].target != SCN_STATE_NONE) res |= GAME_RES_KEYPAD;
+    if (t[SCN_EV_BUTTON].target != SCN_STATE_NONE) res |= GAME_RES_BUTTON;
+    return res;
+}
+
+static uint32_t scn_enter_res(const scenario_t *scn, uint8_t state) {
+    const scn_state_t *st = &scn->states[state];
+    return scn_actions_res(scn, st->enter_first, st->enter_count) | scn_state_focus(scn, state);
+}
+
+static uint32_t scn_transition_res(const scenario_t *scn, scn_event_t ev) {
+    const scn_transition_t *t = &scn->trans[scn->cur * SCN_EV_COUNT + ev];
+    if (t->target == SCN_STATE_NONE) return 0;
+
+    uint32_t res = scn_actions_res(scn, t->action_first, t->action_count);
+    if (t->target != SCN_STATE_STAY) res |= scn_enter_res(scn, t->target);
+    return res;
+}
+
+// Caractère d’un code : écho, puis CODE_OK ou CODE_BAD une fois complet
+static uint32_t scn_code_res(const scenario_t *scn) {
+    if (scn->lock_s) return GAME_RES_LCD;
+    return GAME_RES_LCD | scn_transition_res(scn, SCN_EV_CODE_OK) | scn_transition_res(scn, SCN_EV_CODE_BAD);
+}
+
+// ----------------------------------------------------------------------
+//  Recherche d’un scénario dans le paquet de ressources et vérification
+//  timer : première des SCN_TIMER_COUNT minuteries réservées à l’instance
+// ----------------------------------------------------------------------
+esp_err_t scenario_load(scenario_t *scn, const char *name, game_timer_id_t timer) {
+    size_t len;
+    const void *blob = assets_find(name, ASSET_SCENARIO, &len);
+    if (blob == NULL) {
+        ESP_LOGE(TAG, "Scénario \"%s\" absent du paquet de ressources", name);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_err_t err = scenario_validate(blob, len);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Scénario \"%s\" invalide (%s)", name, esp_err_to_name(err));
+        return err;
+    }
+
+    scn->hdr = blob;
+    scn->states = (const void *)(scn->hdr + 1);
+    scn->trans = (const void *)(scn->states + scn->hdr->state_count);
+    scn->hints = (const void *)(scn->trans + scn->hdr->state_count * SCN_EV_COUNT);
+    scn->actions = (const void *)(scn->hints + scn->hdr->hint_count);
+    scn->secrets = (const void *)(scn->actions + scn->hdr->action_count);
+    scn->strings = (const void *)(scn->secrets + scn->hdr->secret_count);
+    scn->timer = timer;
+    scn->done = true;                 // Pas encore démarré
+
+    ESP_LOGI(TAG, "Scénario \"%s\" chargé : %d états, %d actions, %lu octets",
+             name, scn->hdr->state_count, scn->hdr->action_count, (unsigned long)scn->hdr->size);
+    return ESP_OK;
+}
+
+// ----------------------------------------------------------------------
+//  Interprète
+// ----------------------------------------------------------------------
+static Led *scn_led(uint8_t idx) {
+    switch (idx) {
+    case 0:  return get_led_ep1();
+    case 1:  return get_led_ep2();
+    default: return get_led_err();
+    }
+}
+
+static void scn_run(scenario_t *scn, uint16_t first, uint8_t count) {
+    for (const scn_action_t *a = &scn->actions[first]; count--; a++) {
+        switch (a->op) {
+        case SCN_OP_END:        scn->done = true; break;
+        case SCN_OP_LCD_CLEAR:  lcd_clear(); break;
+        case SCN_OP_LCD_PRINT:
+            lcd_set_cursor(a->a, 0);
+            lcd_print(&scn->strings[a->b]);
+            break;
+        case SCN_OP_LED_ON:     leds_set(a->a, 0); break;
+        case SCN_OP_LED_OFF:    leds_set(0, a->a); break;
+        case SCN_OP_LED_EFFECT: led_effect_start(scn_led(a->a), s_effects[a->b]); break;
+        case SCN_OP_MORSE:      leds_morse_start(&scn->strings[a->b]); break;
+        case SCN_OP_TIMER:
+            if (a->b) game_timer_start(scn->timer + SCN_TIMER_STATE, a->b);
+            else game_timer_stop(scn->timer + SCN_TIMER_STATE);
+            break;
+        }
+    }
+}
+
+// Temps restant, affiché seulement pendant la saisie d’un code
+static void scn_draw_clock(const scenario_t *scn) {
+    const scn_header_t *h = scn->hdr;
+    if (h->time_limit_s == 0 || h->countdown_row == SCN_NO_COUNTDOWN) return;
+    if (scn->states[scn->cur].code_len == 0) return;
+
+    char buf[SCN_COUNTDOWN_LEN + 1];
+    snprintf(buf, sizeof(buf), "%02u:%02u", scn->remaining_s / 60, scn->remaining_s % 60);
+    lcd_set_cursor(h->countdown_row, h->countdown_col);
+    lcd_print(buf);
+}
+
+// Temps de blocage restant, à la place du code en cours de saisie
+static void scn_draw_lock(const scenario_t *scn) {
+    if (scn->states[scn->cur].code_len == 0) return;
+
+    char buf[SCN_LOCK_LEN + 1];
+    if (scn->lock_s) snprintf(buf, sizeof(buf), SCN_LOCK_FMT, scn->lock_s);
+    else snprintf(buf, sizeof(buf), "%*s", SCN_LOCK_LEN, "");
+    lcd_set_cursor(scn->line.row, scn->line.col);
+    lcd_print(buf);
+}
+
+// Blocage de la saisie : lockout_s, doublé à chaque récidive
+static void scn_lock(scenario_t *scn) {
+    uint32_t s = (uint32_t)scn->hdr->lockout_s << (scn->lockouts < 10 ? scn->lockouts : 10);   // Plafonné plus bas
+
+    scn->failures = 0;
+    if (scn->lockouts < UINT8_MAX) scn->lockouts++;
+    scn->lock_s = s < SCN_LOCKOUT_MAX_S ? s : SCN_LOCKOUT_MAX_S;
+    scn_draw_lock(scn);
+    game_timer_every(scn->timer + SCN_TIMER_LOCK, 1000);
+    ESP_LOGI(TAG, "Saisie bloquée %u s (blocage n°%u)", scn->lock_s, scn->lockouts);
+}
+
+// Une seconde de blocage en moins
+static void scn_lock_tick(scenario_t *scn) {
+    if (scn->lock_s > 0) scn->lock_s--;
+    scn_draw_lock(scn);                       // Blancs à la fin du blocage
+    if (scn->lock_s == 0) game_timer_stop(scn->timer + SCN_TIMER_LOCK);
+}
+
+static void scn_enter(scenario_t *scn, uint8_t state) {
+    const scn_state_t *st = &scn->states[state];
+
+    scn->cur = state;
+    input_line_init(&scn->line, st->code_len, 1, 0, st->input_flags & ~SCN_INPUT_MORSE);   // Écho sur la 2ᵉ ligne
+
+    scn_run(scn, st->enter_first, st->enter_count);
+    scn_draw_clock(scn);
+    if (scn->lock_s) scn_draw_lock(scn);
+    if (st->timeout_ms) game_timer_start(scn->timer + SCN_TIMER_STATE, st->timeout_ms);
+    else game_timer_stop(scn->timer + SCN_TIMER_STATE);
+}
+
+static void scn_transition(scenario_t *scn, scn_event_t ev) {
+    const scn_transition_t *t = &scn->trans[scn->cur * SCN_EV_COUNT + ev];
+    if (t->target == SCN_STATE_NONE) return;
+
+    scn_run(scn, t->action_first, t->action_count);
+    if (t->target != SCN_STATE_STAY && !scn->done) scn_enter(scn, t->target);
+}
+
+// Caractère du code en cours de saisie (clavier ou Morse)
+static void scn_code_input(scenario_t *scn, char key) {
+    const scn_state_t *st = &scn->states[scn->cur];
+    if (scn->lock_s) {                        // Saisie lue, code refusé : rappel du délai
+        scn_draw_lock(scn);
+        return;
+    }
+    if (input_line_key(&scn->line, key) != INPUT_LINE_SUBMIT) return;
+
+    bool ok = secret_verify(&scn->secrets[st->secret], input_line_text(&scn->line),
+                            input_line_len(&scn->line));
+    input_line_clear(&scn->line);
+    analytics_attempt(&scn->stats, ok);
+    scn_transition(scn, ok ? SCN_EV_CODE_OK : SCN_EV_CODE_BAD);
+
+    if (ok) {
+        scn->failures = 0;
+        scn->lockouts = 0;
+    } else if (scn->hdr->lockout_failures && ++scn->failures >= scn->hdr->lockout_failures) {
+        scn_lock(scn);
+    }
+}
+
+// Touche : saisie du code si l’état en attend un au clavier, sinon événement simple
+static void scn_key(scenario_t *scn, char key) {
+    const scn_state_t *st = &scn->states[scn->cur];
+    if (st->code_len == 0) {
+        scn_transition(scn, SCN_EV_KEY);
+        return;
+    }
+    if (!(st->input_flags & SCN_INPUT_MORSE)) scn_code_input(scn, key);
+}
+
+// Caractère décodé au bouton : saisie du code si l’état l’attend en Morse
+static void scn_morse(scenario_t *scn, char c) {
+    const scn_state_t *st = &scn->states[scn->cur];
+    if (st->code_len == 0 || !(st->input_flags & SCN_INPUT_MORSE) || c == ' ') return;
+    scn_code_input(scn, c);
+}
+
+// ----------------------------------------------------------------------
+//  Temps de partie
+// ----------------------------------------------------------------------
+static void scn_stop_timers(scenario_t *scn) {
+    for (int i = 0; i < SCN_TIMER_COUNT; i++) game_timer_stop(scn->timer + i);
+}
+
+// Indice suivant, puis programmation du prochain
+static void scn_hint(scenario_t *scn) {
+    const scn_hint_t *hint = &scn->hints[scn->next_hint++];
+    scn_run(scn, hint->action_first, hint->action_count);
+    analytics_hint(&scn->stats);
+
+    if (scn->next_hint < scn->hdr->hint_count) {
+        uint16_t wait_s = scn->hints[scn->next_hint].after_s - hint->after_s;
+        game_timer_start(scn->timer + SCN_TIMER_HINT, wait_s * 1000u);
+    }
+}
+
+// Une seconde de moins ; à zéro, la partie est perdue
+static void scn_tick(scenario_t *scn) {
+    if (scn->remaining_s > 0) scn->remaining_s--;
+    scn_draw_clock(scn);
+    if (scn->remaining_s > 0) return;
+
+    ESP_LOGI(TAG, "Temps écoulé");
+    scn->expired = true;
+    scn->lock_s = 0;
+    scn_stop_timers(scn);
+    input_line_wipe(&scn->line);
+    if (scn->hdr->expired_state != SCN_STATE_NONE) scn_enter(scn, scn->hdr->expired_state);
+    else scn->done = true;
+}
+
+void scenario_start(scenario_t *scn) {
+    const scn_header_t *h = scn->hdr;
+
+    scn->done = false;
+    scn->expired = false;
+    scn->failures = 0;
+    scn->lockouts = 0;
+    scn->lock_s = 0;
+    scn->next_hint = 0;
+    scn->remaining_s = h->time_limit_s;
+    analytics_begin(&scn->stats);
+
+    if (h->time_limit_s) game_timer_every(scn->timer + SCN_TIMER_CLOCK, 1000);
+    if (h->hint_count) game_timer_start(scn->timer + SCN_TIMER_HINT, scn->hints[0].after_s * 1000u);
+    scn_enter(scn, h->initial);
+}
+
+// ----------------------------------------------------------------------
+//  Ressources à détenir pour traiter ev (NULL : démarrage), focus de
+//  l’état courant compris. Toutes les suites possibles sont comptées
+//  (code juste ou faux, fin du temps) : l’appelant les obtient d’un coup.
+// ----------------------------------------------------------------------
+uint32_t scenario_needs(const scenario_t *scn, const game_event_t *ev) {
+    if (ev == NULL) return scn_enter_res(scn, scn->hdr->initial);
+    if (scn->done) return 0;
+
+    const scn_state_t *st = &scn->states[scn->cur];
+    uint32_t res = scn_state_focus(scn, scn->cur);
+    switch (ev->type) {
+    case GAME_EVT_KEY:
+        if (st->code_len == 0) res |= scn_transition_res(scn, SCN_EV_KEY);
+        else if (!(st->input_flags & SCN_INPUT_MORSE)) res |= scn_code_res(scn);
+        break;
+    case GAME_EVT_BUTTON:
+        if (ev->arg) res |= scn_transition_res(scn, SCN_EV_BUTTON);
+        break;
+    case GAME_EVT_MORSE:
+        if (st->code_len && (st->input_flags & SCN_INPUT_MORSE)) res |= scn_code_res(scn);
+        break;
+    case GAME_EVT_TIMER:
+        switch (ev->arg - scn->timer) {
+        case SCN_TIMER_STATE: res |= scn_transition_res(scn, SCN_EV_TIMEOUT); break;
+        case SCN_TIMER_CLOCK:
+            if (scn->remaining_s <= 1 && scn->hdr->expired_state != SCN_STATE_NONE) {
+                res |= scn_enter_res(scn, scn->hdr->expired_state);
+            }
+            break;
+        case SCN_TIMER_HINT:
+            if (scn->next_hint < scn->hdr->hint_count) {
+                const scn_hint_t *hint = &scn->hints[scn->next_hint];
+                res |= scn_actions_res(scn, hint->action_first, hint->action_count);
+            }
+            break;
+        }
+        break;
+    case GAME_EVT_NET:
+        res |= scn_transition_res(scn, SCN_EV_NET);
+        break;
+    }
+    return res;
+}
+
+// Ressources gardées entre deux événements : celles de l’entrée attendue
+uint32_t scenario_focus(const scenario_t *scn) {
+    return scn->done ? 0 : scn_state_focus(scn, scn->cur);
+}
+
+// ----------------------------------------------------------------------
+//  Traite un événement du jeu
+//  Retourne false lorsque le scénario est terminé.
+// ----------------------------------------------------------------------
+bool scenario_dispatch(scenario_t *scn, const game_event_t *ev) {
+    switch (ev->type) {
+    case GAME_EVT_KEY:
+        scn_key(scn, (char)ev->arg);
+        break;
+    case GAME_EVT_BUTTON:
+        if (ev->arg) scn_transition(scn, SCN_EV_BUTTON);   // Appui seulement
+        break;
+    case GAME_EVT_MORSE:
+        scn_morse(scn, (char)ev->arg);
+        break;
+    case GAME_EVT_TIMER:
+        switch (ev->arg - scn->timer) {       // Minuteries des autres énigmes ignorées
+        case SCN_TIMER_STATE: scn_transition(scn, SCN_EV_TIMEOUT); break;
+        case SCN_TIMER_CLOCK: scn_tick(scn); break;
+        case SCN_TIMER_HINT:  scn_hint(scn); break;
+        case SCN_TIMER_LOCK:  scn_lock_tick(scn); break;
+        }
+        break;
+    case GAME_EVT_NET:
+        scn_transition(scn, SCN_EV_NET);
+        break;
+    }
+    if (scn->done) scn_stop_timers(scn);
+    return !scn->done;
+}
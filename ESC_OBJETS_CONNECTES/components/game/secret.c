@@ -0,0 +1,68 @@
+// ======================================================================
+//  Module : secret.c
+//  Description : Vérification d’un code secret par empreinte salée
+//  Fonctionnement :
+//     - Le code n’est jamais stocké en clair : seul SHA-256(sel || code)
+//       figure dans le paquet de ressources.
+//     - Le calcul passe par mbedtls, qui utilise l’accélérateur SHA de
+//       l’ESP32 lorsque CONFIG_MBEDTLS_HARDWARE_SHA est activé.
+//     - La comparaison des empreintes se fait en temps constant : la
+//       durée ne révèle pas combien d’octets correspondent.
+// ======================================================================
+
+#include "secret.h"
+#include "sdkconfig.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/constant_time.h"
+#include "mbedtls/platform_util.h"
+#include "esp_log.h"
+#if CONFIG_GAME_SECRET_BENCH
+#include "esp_timer.h"
+#include "esp_cpu.h"
+#endif
+
+// ----------------------------------------------------------------------
+//  Vérifie un code saisi
+// ----------------------------------------------------------------------
+bool secret_verify(const secret_t *secret, const char *code, size_t len) {
+    uint8_t digest[SECRET_DIGEST_LEN];
+    mbedtls_sha256_context ctx;
+
+    mbedtls_sha256_init(&ctx);
+    mbedtls_sha256_starts(&ctx, 0);                        // 0 = SHA-256
+    mbedtls_sha256_update(&ctx, secret->salt, SECRET_SALT_LEN);
+    mbedtls_sha256_update(&ctx, (const uint8_t *)code, len);
+    mbedtls_sha256_finish(&ctx, digest);
+    mbedtls_sha256_free(&ctx);
+
+    bool ok = mbedtls_ct_memcmp(digest, secret->digest, SECRET_DIGEST_LEN) == 0;
+    mbedtls_platform_zeroize(digest, sizeof(digest));
+    return ok;
+}
+
+#if CONFIG_GAME_SECRET_BENCH
+static const char *TAG = "secret";
+
+// ----------------------------------------------------------------------
+//  Mesure le coût d’une vérification (CONFIG_GAME_SECRET_BENCH)
+//  Même chemin qu’une vraie tentative : sel + code de 5 caractères.
+// ----------------------------------------------------------------------
+void secret_benchmark(void) {
+    static const secret_t dummy = {0};
+    const int runs = 1000;
+
+    int64_t t0 = esp_timer_get_time();
+    uint32_t c0 = esp_cpu_get_cycle_count();
+    for (int i = 0; i < runs; i++) secret_verify(&dummy, "00000", 5);
+    uint32_t cycles = esp_cpu_get_cycle_count() - c0;
+    int64_t us = esp_timer_get_time() - t0;
+
+#if CONFIG_MBEDTLS_HARDWARE_SHA
+    const char *engine = "matériel";
+#else
+    const char *engine = "logiciel";
+#endif
+    ESP_LOGI(TAG, "SHA-256 %s : %lld ns, %lu cycles par vérification", engine,
+             (long long)(us * 1000 / runs), (unsigned long)(cycles / runs));
+}
+#endif
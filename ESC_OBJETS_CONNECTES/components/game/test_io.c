@@ -0,0 +1,97 @@
+// ======================================================================
+//  Module : test_io.c
+//  Description : Entrées de test lues sur la console série
+//  Fonctionnement :
+//     - Remplace le doigt du joueur pour les tests sous QEMU, où le
+//       clavier et le bouton n’existent pas : les commandes reçues sur
+//       l’UART de la console deviennent des événements du jeu, déposés
+//       dans la même file que ceux des pilotes.
+//     - La boucle du jeu appelle test_io_report() après chaque
+//       événement : si le texte de l’écran a changé (copie tenue par
+//       lcd.c), il est écrit sur la console avec la latence mesurée.
+//     - Réservé aux tests (CONFIG_GAME_TEST_IO) : la console accepte
+//       alors n’importe quelle saisie comme une touche.
+// ======================================================================
+
+#include "test_io.h"
+#include "sdkconfig.h"
+
+#if CONFIG_GAME_TEST_IO
+#include "lcd.h"
+#include "hal_time.h"
+#include "driver/uart.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "test_io";
+
+#define TEST_IO_UART     CONFIG_ESP_CONSOLE_UART_NUM
+#define TEST_IO_LINE_LEN 64
+
+static uint32_t s_reported = 0;
+
+// ----------------------------------------------------------------------
+//  Une commande de la console
+// ----------------------------------------------------------------------
+static void test_io_command(char *line) {
+    if (strncmp(line, "key ", 4) == 0) {
+        for (const char *k = line + 4; *k; k++) {
+            if (*k != ' ') game_event_post(GAME_SRC_CONSOLE, GAME_EVT_KEY, (uint8_t)*k);
+        }
+    } else if (strncmp(line, "button ", 7) == 0) {
+        game_event_post(GAME_SRC_CONSOLE, GAME_EVT_BUTTON, atoi(line + 7) ? 1 : 0);
+    } else if (strncmp(line, "morse ", 6) == 0) {
+        // Décodage non rejoué : le temps de QEMU n’est pas celui d’un joueur
+        for (const char *c = line + 6; *c; c++) game_event_post(GAME_SRC_CONSOLE, GAME_EVT_MORSE, (uint8_t)*c);
+    } else if (line[0] != '\0') {
+        ESP_LOGW(TAG, "Commande inconnue : %s", line);
+    }
+}
+
+static void test_io_task(void *arg) {
+    char line[TEST_IO_LINE_LEN];
+    size_t len = 0;
+
+    for (;;) {
+        uint8_t c;
+        if (uart_read_bytes(TEST_IO_UART, &c, 1, portMAX_DELAY) != 1) continue;
+        if (c == '\r' || c == '\n') {
+            line[len] = '\0';
+            test_io_command(line);
+            len = 0;
+        } else if (len < sizeof(line) - 1) {
+            line[len++] = (char)c;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Lecture de la console, sur le cœur de l’appelant (celui des entrées)
+// ----------------------------------------------------------------------
+void test_io_start(void) {
+    ESP_ERROR_CHECK(uart_driver_install(TEST_IO_UART, 256, 0, 0, NULL, 0));
+    static StackType_t stack[3072];
+    static StaticTask_t tcb;
+    xTaskCreateStaticPinnedToCore(test_io_task, "test_io", sizeof(stack), NULL, 5, stack, &tcb, xPortGetCoreID());
+    printf("TESTIO ready\n");
+}
+
+// ----------------------------------------------------------------------
+//  Écran après un événement (NULL : premier affichage du jeu)
+// ----------------------------------------------------------------------
+void test_io_report(const game_event_t *ev) {
+    uint32_t version = lcd_framebuffer_version();
+    if (version == s_reported) return;
+    s_reported = version;
+
+    char rows[LCD_ROWS][LCD_COLS + 1];
+    for (int r = 0; r < LCD_ROWS; r++) lcd_framebuffer(r, rows[r]);
+    int64_t now = hal_time_us();
+    printf("TESTIO lcd t=%lld lat=%lld |%s|%s|\n", (long long)now,
+           (long long)(ev ? now - ev->t_us : -1), rows[0], rows[1]);
+}
+#endif
@@ -0,0 +1,378 @@
+// ======================================================================
+//  Module : hal_host.c
+//  Description : HAL de la cible linux (carte simulée)
+//  Fonctionnement :
+//     - Les broches sont un tableau d’états : niveau écrit par le
+//       firmware, niveau imposé de l’extérieur, tirage interne, ISR.
+//     - Les écritures (sorties, I2C, PWM) sont transmises à la carte
+//       branchée par hal_host_attach() ; sans carte, elles sont ignorées.
+//     - Les minuteries sont des échéances sur l’horloge de la carte,
+//       exécutées par une tâche de la priorité de la tâche inactive.
+//     - Horloge réelle : la tâche exécute les échéances passées à chaque
+//       tick. Horloge pilotée : quand elle obtient le processeur, toutes
+//       les autres tâches sont bloquées ; elle saute alors à la prochaine
+//       échéance, plus vite que le temps réel.
+// ======================================================================
+
+#include "hal_host.h"
+#include "hal_i2c.h"
+#include "hal_pwm.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <time.h>
+#include <unistd.h>
+
+static const char *TAG = "hal_host";
+
+#define HAL_HOST_TIMERS   8
+#define HAL_HOST_CHANNELS 8
+#define NEVER             INT64_MAX
+
+typedef struct {
+    uint8_t output;        // 1 : sortie
+    uint8_t level;         // Niveau écrit par le firmware
+    uint8_t driven;        // 1 : niveau imposé de l’extérieur
+    uint8_t driven_level;
+    uint8_t pull;          // hal_pull_t
+    uint8_t edge;          // hal_edge_t
+    uint8_t intr;          // Interruption active
+    uint8_t pwm;           // 1 : sortie prise par un canal PWM
+    hal_isr_t isr;
+    void *arg;
+} host_pin_t;
+
+struct hal_timer {
+    hal_timer_cb_t cb;
+    void *arg;
+    const char *name;
+    int64_t due_us;        // NEVER : inactive
+};
+
+static host_pin_t s_pins[HAL_HOST_PINS];
+static const hal_host_board_t *s_board = NULL;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static struct hal_timer s_timers[HAL_HOST_TIMERS];
+static int s_timer_count = 0;
+static TaskHandle_t s_clock_task = NULL;
+
+static int64_t s_epoch_us = 0;     // Horloge réelle : instant du premier appel
+static bool s_manual = false;
+static int64_t s_now_us;           // Horloge pilotée
+static int64_t s_wake_us = NEVER;  // Prochain réveil demandé (horloge pilotée)
+
+static hal_pin_t s_pwm_pin[HAL_HOST_CHANNELS];    // -1 : canal détaché
+static uint32_t s_pwm_duty[HAL_HOST_CHANNELS];
+
+// ----------------------------------------------------------------------
+//  Carte
+// ----------------------------------------------------------------------
+void hal_host_attach(const hal_host_board_t *board) {
+    s_board = board;
+}
+
+static int pin_level(const host_pin_t *p) {
+    if (p->output) return p->level;
+    if (p->driven) return p->driven_level;
+    return p->pull == HAL_PULL_UP;
+}
+
+// ----------------------------------------------------------------------
+//  GPIO
+// ----------------------------------------------------------------------
+void hal_gpio_output(hal_pin_t pin) {
+    portENTER_CRITICAL(&s_lock);
+    s_pins[pin].output = 1;
+    s_pins[pin].level = 0;
+    s_pins[pin].intr = 0;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void hal_gpio_input(hal_pin_t pin, hal_pull_t pull) {
+    portENTER_CRITICAL(&s_lock);
+    s_pins[pin].output = 0;
+    s_pins[pin].pull = pull;
+    s_pins[pin].intr = 0;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void hal_gpio_set(hal_pin_t pin, int level) {
+    level = level != 0;
+    portENTER_CRITICAL(&s_lock);
+    bool changed = s_pins[pin].level != level;
+    s_pins[pin].level = level;
+    portEXIT_CRITICAL(&s_lock);
+
+    // Broche prise par un canal PWM : le niveau reste en attente
+    if (changed && !s_pins[pin].pwm && s_board != NULL && s_board->output != NULL) {
+        s_board->output(pin, level);
+    }
+}
+
+int hal_gpio_get(hal_pin_t pin) {
+    return pin_level(&s_pins[pin]);
+}
+
+void hal_gpio_write_mask(uint32_t set_mask, uint32_t clear_mask) {
+    for (hal_pin_t pin = 0; pin < 32; pin++) {
+        if (set_mask & (1u << pin)) hal_gpio_set(pin, 1);
+        else if (clear_mask & (1u << pin)) hal_gpio_set(pin, 0);
+    }
+}
+
+void hal_gpio_isr_add(hal_pin_t pin, hal_edge_t edge, hal_isr_t isr, void *arg) {
+    portENTER_CRITICAL(&s_lock);
+    s_pins[pin].edge = edge;
+    s_pins[pin].isr = isr;
+    s_pins[pin].arg = arg;
+    s_pins[pin].intr = 1;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void hal_gpio_intr_enable(hal_pin_t pin, bool enable) {
+    s_pins[pin].intr = enable;
+}
+
+// La carte simulée ne dort jamais
+void hal_gpio_wakeup(hal_pin_t pin, int level) {
+}
+
+void hal_host_drive(hal_pin_t pin, int level) {
+    host_pin_t *p = &s_pins[pin];
+
+    portENTER_CRITICAL(&s_lock);
+    int before = pin_level(p);
+    p->driven = level >= 0;
+    p->driven_level = level > 0;
+    int after = pin_level(p);
+    bool fire = after != before && p->intr && p->isr != NULL &&
+                (p->edge == HAL_EDGE_ANY || after == 0);
+    hal_isr_t isr = p->isr;
+    void *arg = p->arg;
+    portEXIT_CRITICAL(&s_lock);
+
+    if (fire) isr(arg);
+}
+
+int hal_host_output(hal_pin_t pin) {
+    return s_pins[pin].level;
+}
+
+// ----------------------------------------------------------------------
+//  I2C : les octets sont remis tels quels au périphérique de la carte
+// ----------------------------------------------------------------------
+void hal_i2c_init(hal_pin_t sda, hal_pin_t scl, uint32_t freq_hz) {
+    ESP_LOGI(TAG, "I2C simulé (SDA %d, SCL %d)", sda, scl);
+}
+
+esp_err_t hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len) {
+    if (s_board == NULL || s_board->i2c_write == NULL) return ESP_FAIL;
+    return s_board->i2c_write(addr, data, len) ? ESP_OK : ESP_FAIL;
+}
+
+// ----------------------------------------------------------------------
+//  PWM : rapport cyclique transmis à la carte (fondu compris)
+// ----------------------------------------------------------------------
+static void pwm_notify(hal_pwm_channel_t ch, uint32_t fade_ms) {
+    hal_pin_t pin = s_pwm_pin[ch];
+    if (pin >= 0 && s_board != NULL && s_board->pwm != NULL) s_board->pwm(pin, s_pwm_duty[ch], fade_ms);
+}
+
+void hal_pwm_init(uint32_t freq_hz) {
+    for (int i = 0; i < HAL_HOST_CHANNELS; i++) s_pwm_pin[i] = -1;
+}
+
+void hal_pwm_channel_init(hal_pwm_channel_t ch, hal_pin_t pin) {
+    s_pwm_duty[ch] = 0;
+    hal_pwm_attach(ch, pin);
+}
+
+void hal_pwm_attach(hal_pwm_channel_t ch, hal_pin_t pin) {
+    s_pwm_pin[ch] = pin;
+    s_pins[pin].pwm = 1;
+    pwm_notify(ch, 0);
+}
+
+// La broche reprend le niveau écrit en dernier par le GPIO
+void hal_pwm_detach(hal_pin_t pin) {
+    for (int i = 0; i < HAL_HOST_CHANNELS; i++) {
+        if (s_pwm_pin[i] == pin) s_pwm_pin[i] = -1;
+    }
+    s_pins[pin].pwm = 0;
+    if (s_board != NULL && s_board->output != NULL) s_board->output(pin, s_pins[pin].level);
+}
+
+void hal_pwm_fade(hal_pwm_channel_t ch, uint32_t duty, uint32_t fade_ms) {
+    s_pwm_duty[ch] = duty;
+    pwm_notify(ch, fade_ms);
+}
+
+void hal_pwm_set(hal_pwm_channel_t ch, uint32_t duty) {
+    hal_pwm_fade(ch, duty, 0);
+}
+
+// ----------------------------------------------------------------------
+//  Horloge
+// ----------------------------------------------------------------------
+static int64_t real_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t t = (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    if (s_epoch_us == 0) s_epoch_us = t;
+    return t - s_epoch_us;
+}
+
+int64_t hal_time_us(void) {
+    return s_manual ? s_now_us : real_us();
+}
+
+// Pas de compteur de cycles accessible : nanosecondes de l’horloge réelle
+uint32_t hal_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+
+void hal_host_clock_manual(bool manual) {
+    portENTER_CRITICAL(&s_lock);
+    if (manual && !s_manual) s_now_us = real_us();   // Pas de retour en arrière
+    s_manual = manual;
+    portEXIT_CRITICAL(&s_lock);
+    ESP_LOGI(TAG, "Horloge %s", manual ? "pilotée" : "réelle");
+}
+
+void hal_host_wake_at(int64_t t_us) {
+    portENTER_CRITICAL(&s_lock);
+    if (t_us < s_wake_us) s_wake_us = t_us;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+// ----------------------------------------------------------------------
+//  Exécute, dans l’ordre, les minuteries échues jusqu’à t_us
+//  L’horloge pilotée avance d’échéance en échéance, puis jusqu’à t_us.
+// ----------------------------------------------------------------------
+static void clock_run(int64_t t_us) {
+    for (;;) {
+        struct hal_timer *due = NULL;
+
+        portENTER_CRITICAL(&s_lock);
+        for (int i = 0; i < s_timer_count; i++) {
+            struct hal_timer *t = &s_timers[i];
+            if (t->due_us <= t_us && (due == NULL || t->due_us < due->due_us)) due = t;
+        }
+        if (due != NULL) {
+            if (s_manual && due->due_us > s_now_us) s_now_us = due->due_us;
+            due->due_us = NEVER;
+        } else if (s_manual && t_us > s_now_us) {
+            s_now_us = t_us;
+        }
+        portEXIT_CRITICAL(&s_lock);
+
+        if (due == NULL) return;
+        due->cb(due->arg);
+    }
+}
+
+// Prochaine échéance de l’horloge pilotée (réveil demandé consommé)
+static int64_t clock_next(void) {
+    portENTER_CRITICAL(&s_lock);
+    int64_t next = s_wake_us;
+    s_wake_us = NEVER;
+    for (int i = 0; i < s_timer_count; i++) {
+        if (s_timers[i].due_us < next) next = s_timers[i].due_us;
+    }
+    portEXIT_CRITICAL(&s_lock);
+    return next;
+}
+
+// ----------------------------------------------------------------------
+//  Tâche de l’horloge, à la priorité de la tâche inactive : elle ne
+//  s’exécute que lorsque toutes les autres tâches attendent.
+// ----------------------------------------------------------------------
+static void clock_task(void *arg) {
+    for (;;) {
+        vTaskDelay(1);
+        if (!s_manual) {
+            clock_run(real_us());
+            continue;
+        }
+        int64_t next = clock_next();
+        if (next != NEVER) clock_run(next);
+    }
+}
+
+static void clock_start(void) {
+    if (s_clock_task != NULL) return;
+    xTaskCreate(clock_task, "hal_clock", 4096, NULL, tskIDLE_PRIORITY, &s_clock_task);
+}
+
+// ----------------------------------------------------------------------
+//  Attente bornée d’une tâche bloquée sur une file (boucle du jeu)
+//  Horloge pilotée : l’échéance devient un réveil ; la tâche revérifie
+//  l’horloge à chaque tick, après le saut éventuel.
+// ----------------------------------------------------------------------
+TickType_t hal_ticks_until(int64_t until_us) {
+    if (until_us == INT64_MAX) return portMAX_DELAY;
+    int64_t left = until_us - hal_time_us();
+    if (left <= 0) return 0;
+    if (s_manual) {
+        clock_start();
+        hal_host_wake_at(until_us);
+        return 1;
+    }
+    const int64_t tick_us = portTICK_PERIOD_MS * 1000LL;
+    return (TickType_t)((left + tick_us - 1) / tick_us);
+}
+
+// ----------------------------------------------------------------------
+//  Attentes
+//  Horloge pilotée : l’attente active fait avancer l’horloge (le
+//  processeur est occupé pendant ce temps) ; l’attente passive demande
+//  un réveil et laisse la tâche de l’horloge sauter jusqu’à lui.
+// ----------------------------------------------------------------------
+void hal_delay_us(uint32_t us) {
+    if (s_manual) clock_run(s_now_us + us);
+    else usleep(us);
+}
+
+void hal_delay_ms(uint32_t ms) {
+    if (!s_manual) {
+        vTaskDelay(pdMS_TO_TICKS(ms));
+        return;
+    }
+    clock_start();
+    int64_t until = s_now_us + (int64_t)ms * 1000;
+    while (s_manual && s_now_us < until) {
+        hal_host_wake_at(until);
+        vTaskDelay(1);
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Minuteries one-shot
+// ----------------------------------------------------------------------
+hal_timer_t hal_timer_create(hal_timer_cb_t cb, void *arg, const char *name) {
+    ESP_ERROR_CHECK(s_timer_count < HAL_HOST_TIMERS ? ESP_OK : ESP_ERR_NO_MEM);
+    clock_start();
+
+    portENTER_CRITICAL(&s_lock);
+    struct hal_timer *t = &s_timers[s_timer_count++];
+    *t = (struct hal_timer){.cb = cb, .arg = arg, .name = name, .due_us = NEVER};
+    portEXIT_CRITICAL(&s_lock);
+    return t;
+}
+
+void hal_timer_start_once(hal_timer_t timer, uint64_t delay_us) {
+    int64_t now = hal_time_us();
+    portENTER_CRITICAL(&s_lock);
+    timer->due_us = now + (int64_t)delay_us;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void hal_timer_stop(hal_timer_t timer) {
+    portENTER_CRITICAL(&s_lock);
+    timer->due_us = NEVER;
+    portEXIT_CRITICAL(&s_lock);
+}
@@ -0,0 +1,96 @@
+#ifndef HAL_GPIO_H
+#define HAL_GPIO_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_attr.h"
+#include "sdkconfig.h"
+
+// ----------------------------------------------------------------------
+//  HAL GPIO : broches numérotées comme sur l’ESP32
+//  ESP32 : fonctions inline sur le pilote gpio, aucun appel ajouté
+//  linux : broches simulées (hal_host.c)
+// ----------------------------------------------------------------------
+typedef int hal_pin_t;
+typedef void (*hal_isr_t)(void *arg);
+
+typedef enum {
+    HAL_PULL_NONE,
+    HAL_PULL_UP,
+    HAL_PULL_DOWN,
+} hal_pull_t;
+
+typedef enum {
+    HAL_EDGE_FALLING,
+    HAL_EDGE_ANY,
+} hal_edge_t;
+
+#if CONFIG_IDF_TARGET_LINUX
+
+void hal_gpio_output(hal_pin_t pin);
+void hal_gpio_input(hal_pin_t pin, hal_pull_t pull);
+void hal_gpio_set(hal_pin_t pin, int level);
+int hal_gpio_get(hal_pin_t pin);
+void hal_gpio_write_mask(uint32_t set_mask, uint32_t clear_mask);
+void hal_gpio_isr_add(hal_pin_t pin, hal_edge_t edge, hal_isr_t isr, void *arg);
+void hal_gpio_intr_enable(hal_pin_t pin, bool enable);
+void hal_gpio_wakeup(hal_pin_t pin, int level);
+
+#else
+
+#include "driver/gpio.h"
+#include "soc/gpio_reg.h"          // GPIO_OUT_W1TS_REG / GPIO_OUT_W1TC_REG
+#include "soc/soc.h"               // REG_WRITE
+#include "esp_sleep.h"            // Réveil du sommeil léger par GPIO
+#include "esp_err.h"
+
+// Sortie tout-ou-rien
+static inline void hal_gpio_output(hal_pin_t pin) {
+    gpio_reset_pin(pin);
+    gpio_set_direction(pin, GPIO_MODE_OUTPUT);
+}
+
+// Entrée avec résistance de tirage interne éventuelle
+static inline void hal_gpio_input(hal_pin_t pin, hal_pull_t pull) {
+    gpio_reset_pin(pin);
+    gpio_set_direction(pin, GPIO_MODE_INPUT);
+    gpio_set_pull_mode(pin, pull == HAL_PULL_UP ? GPIO_PULLUP_ONLY
+                          : pull == HAL_PULL_DOWN ? GPIO_PULLDOWN_ONLY : GPIO_FLOATING);
+}
+
+static inline void hal_gpio_set(hal_pin_t pin, int level) {
+    gpio_set_level(pin, level);
+}
+
+static inline int hal_gpio_get(hal_pin_t pin) {
+    return gpio_get_level(pin);
+}
+
+// Plusieurs sorties au même instant (GPIO < 32 : un seul registre)
+static inline void hal_gpio_write_mask(uint32_t set_mask, uint32_t clear_mask) {
+    REG_WRITE(GPIO_OUT_W1TS_REG, set_mask);
+    REG_WRITE(GPIO_OUT_W1TC_REG, clear_mask);
+}
+
+// ISR sur front ; le service d’ISR peut déjà avoir été installé par un autre module
+static inline void hal_gpio_isr_add(hal_pin_t pin, hal_edge_t edge, hal_isr_t isr, void *arg) {
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) ESP_ERROR_CHECK(err);
+    gpio_set_intr_type(pin, edge == HAL_EDGE_ANY ? GPIO_INTR_ANYEDGE : GPIO_INTR_NEGEDGE);
+    ESP_ERROR_CHECK(gpio_isr_handler_add(pin, isr, arg));
+}
+
+static inline void hal_gpio_intr_enable(hal_pin_t pin, bool enable) {
+    if (enable) gpio_intr_enable(pin);
+    else gpio_intr_disable(pin);
+}
+
+// Réveille la puce du sommeil léger quand la broche est au niveau level.
+// L’interruption de la broche devient alors une interruption sur niveau :
+// son ISR doit la couper avant de rendre la main.
+static inline void hal_gpio_wakeup(hal_pin_t pin, int level) {
+    ESP_ERROR_CHECK(gpio_wakeup_enable(pin, level ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL));
+    ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
+}
+
+#endif
+#endif
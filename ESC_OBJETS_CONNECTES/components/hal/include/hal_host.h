@@ -0,0 +1,42 @@
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hal_gpio.h"
+#include "hal_time.h"
+
+// ----------------------------------------------------------------------
+//  Carte simulée (cible linux uniquement)
+//
+//  Le firmware voit des broches, un bus I2C et des canaux PWM ; ce qui
+//  est branché dessus (clavier, écran...) est décrit par un
+//  hal_host_board_t. Ses fonctions sont appelées hors section critique,
+//  dans la tâche qui a écrit.
+//
+//  Horloge : réelle par défaut. Pilotée (hal_host_clock_manual), elle
+//  ne bouge que lorsque toutes les tâches sont bloquées et saute alors
+//  directement à la prochaine échéance : minuterie, attente en cours ou
+//  instant demandé par hal_host_wake_at().
+// ----------------------------------------------------------------------
+#define HAL_HOST_PINS 40
+
+typedef struct {
+    void (*output)(hal_pin_t pin, int level);                        // Sortie modifiée
+    bool (*i2c_write)(uint8_t addr, const uint8_t *data, size_t len); // false : pas d’acquittement
+    void (*pwm)(hal_pin_t pin, uint32_t duty, uint32_t fade_ms);      // Broche pilotée par un canal PWM
+} hal_host_board_t;
+
+void hal_host_attach(const hal_host_board_t *board);
+
+// Niveau imposé de l’extérieur sur une broche (-1 : libérée, tirage interne)
+// Un front déclenche l’ISR éventuelle, dans la tâche appelante.
+void hal_host_drive(hal_pin_t pin, int level);
+
+// Niveau écrit par le firmware sur une sortie
+int hal_host_output(hal_pin_t pin);
+
+void hal_host_clock_manual(bool manual);
+void hal_host_wake_at(int64_t t_us);
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef HAL_I2C_H
+#define HAL_I2C_H
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "hal_gpio.h"
+
+// ----------------------------------------------------------------------
+//  HAL I2C : un seul bus maître (écritures uniquement)
+// ----------------------------------------------------------------------
+#define HAL_I2C_TIMEOUT_MS 100
+
+#if CONFIG_IDF_TARGET_LINUX
+
+void hal_i2c_init(hal_pin_t sda, hal_pin_t scl, uint32_t freq_hz);
+esp_err_t hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len);
+
+#else
+
+#include "driver/i2c.h"
+#include "freertos/FreeRTOS.h"
+
+#define HAL_I2C_PORT I2C_NUM_0
+
+static inline void hal_i2c_init(hal_pin_t sda, hal_pin_t scl, uint32_t freq_hz) {
+    i2c_config_t conf = {
+        .mode = I2C_MODE_MASTER,
+        .sda_io_num = sda,
+        .scl_io_num = scl,
+        .sda_pullup_en = GPIO_PULLUP_ENABLE,
+        .scl_pullup_en = GPIO_PULLUP_ENABLE,
+        .master.clk_speed = freq_hz,
+    };
+    ESP_ERROR_CHECK(i2c_param_config(HAL_I2C_PORT, &conf));
+    ESP_ERROR_CHECK(i2c_driver_install(HAL_I2C_PORT, conf.mode, 0, 0, 0));
+}
+
+// Une transaction : START, adresse + écriture, données, STOP
+// Liste de commandes dans la pile de l’appelant : aucune allocation
+static inline esp_err_t hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len) {
+    uint8_t link[I2C_LINK_RECOMMENDED_SIZE(1)];
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(link, sizeof(link));
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write(cmd, data, len, true);
+    i2c_master_stop(cmd);
+    esp_err_t err = i2c_master_cmd_begin(HAL_I2C_PORT, cmd, pdMS_TO_TICKS(HAL_I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    return err;
+}
+
+#endif
+#endif
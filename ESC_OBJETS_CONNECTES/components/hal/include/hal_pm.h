@@ -0,0 +1,57 @@
+#ifndef HAL_PM_H
+#define HAL_PM_H
+#include "sdkconfig.h"
+
+// ----------------------------------------------------------------------
+//  HAL gestion d’énergie : verrous esp_pm autour du travail sensible
+//  au temps. Un verrou tenu empêche le système de descendre sous une
+//  fréquence (ou d’entrer en sommeil léger) ; les prises s’emboîtent.
+//  Sans CONFIG_PM_ENABLE (et sur linux) : fonctions vides.
+// ----------------------------------------------------------------------
+typedef enum {
+    HAL_PM_CPU_MAX,        // Processeur à pleine fréquence (calcul, balayage)
+    HAL_PM_APB_MAX,        // Bus APB à 80 MHz (horloge I2C, LEDC)
+    HAL_PM_NO_SLEEP,       // Pas de sommeil léger (signal en cours)
+} hal_pm_kind_t;
+
+#if CONFIG_PM_ENABLE && !CONFIG_IDF_TARGET_LINUX
+
+#include "esp_pm.h"
+#include "esp_err.h"
+
+typedef esp_pm_lock_handle_t hal_pm_lock_t;
+
+// name apparaît dans esp_pm_dump_locks() (CONFIG_PM_PROFILING)
+static inline hal_pm_lock_t hal_pm_lock_create(hal_pm_kind_t kind, const char *name) {
+    esp_pm_lock_type_t type = kind == HAL_PM_CPU_MAX ? ESP_PM_CPU_FREQ_MAX
+                            : kind == HAL_PM_APB_MAX ? ESP_PM_APB_FREQ_MAX : ESP_PM_NO_LIGHT_SLEEP;
+    hal_pm_lock_t lock;
+    ESP_ERROR_CHECK(esp_pm_lock_create(type, 0, name, &lock));
+    return lock;
+}
+
+// Utilisables depuis une ISR
+static inline void hal_pm_acquire(hal_pm_lock_t lock) {
+    esp_pm_lock_acquire(lock);
+}
+
+static inline void hal_pm_release(hal_pm_lock_t lock) {
+    esp_pm_lock_release(lock);
+}
+
+#else
+
+typedef void *hal_pm_lock_t;
+
+static inline hal_pm_lock_t hal_pm_lock_create(hal_pm_kind_t kind, const char *name) {
+    return NULL;
+}
+
+static inline void hal_pm_acquire(hal_pm_lock_t lock) {
+}
+
+static inline void hal_pm_release(hal_pm_lock_t lock) {
+}
+
+#endif
+#endif
@@ -0,0 +1,80 @@
+#ifndef HAL_PWM_H
+#define HAL_PWM_H
+#include <stdint.h>
+#include "hal_gpio.h"
+
+// ----------------------------------------------------------------------
+//  HAL PWM : canaux LEDC à fondu matériel, une minuterie commune
+//  Une broche rattachée à un canal suit son rapport cyclique ; détachée,
+//  elle reprend le niveau écrit par hal_gpio_set / hal_gpio_write_mask.
+// ----------------------------------------------------------------------
+#define HAL_PWM_BITS     10
+#define HAL_PWM_DUTY_MAX ((1u << HAL_PWM_BITS) - 1)
+
+typedef uint8_t hal_pwm_channel_t;
+
+#if CONFIG_IDF_TARGET_LINUX
+
+void hal_pwm_init(uint32_t freq_hz);
+void hal_pwm_channel_init(hal_pwm_channel_t ch, hal_pin_t pin);
+void hal_pwm_attach(hal_pwm_channel_t ch, hal_pin_t pin);
+void hal_pwm_detach(hal_pin_t pin);
+void hal_pwm_set(hal_pwm_channel_t ch, uint32_t duty);
+void hal_pwm_fade(hal_pwm_channel_t ch, uint32_t duty, uint32_t fade_ms);
+
+#else
+
+#include "driver/ledc.h"
+#include "esp_rom_gpio.h"          // Routage de la matrice GPIO
+#include "soc/gpio_sig_map.h"      // SIG_GPIO_OUT_IDX
+#include "esp_err.h"
+
+#define HAL_PWM_MODE  LEDC_LOW_SPEED_MODE
+#define HAL_PWM_TIMER LEDC_TIMER_0
+
+// Minuterie PWM et service de fondu
+static inline void hal_pwm_init(uint32_t freq_hz) {
+    const ledc_timer_config_t timer = {
+        .speed_mode = HAL_PWM_MODE,
+        .duty_resolution = (ledc_timer_bit_t)HAL_PWM_BITS,
+        .timer_num = HAL_PWM_TIMER,
+        .freq_hz = freq_hz,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+    ESP_ERROR_CHECK(ledc_timer_config(&timer));
+    ESP_ERROR_CHECK(ledc_fade_func_install(0));
+}
+
+// Canal éteint, broche rattachée
+static inline void hal_pwm_channel_init(hal_pwm_channel_t ch, hal_pin_t pin) {
+    const ledc_channel_config_t channel = {
+        .gpio_num = pin,
+        .speed_mode = HAL_PWM_MODE,
+        .channel = (ledc_channel_t)ch,
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = HAL_PWM_TIMER,
+        .duty = 0,
+        .hpoint = 0,
+    };
+    ESP_ERROR_CHECK(ledc_channel_config(&channel));
+}
+
+static inline void hal_pwm_attach(hal_pwm_channel_t ch, hal_pin_t pin) {
+    ledc_set_pin(pin, HAL_PWM_MODE, (ledc_channel_t)ch);
+}
+
+static inline void hal_pwm_detach(hal_pin_t pin) {
+    esp_rom_gpio_connect_out_signal(pin, SIG_GPIO_OUT_IDX, false, false);
+}
+
+static inline void hal_pwm_set(hal_pwm_channel_t ch, uint32_t duty) {
+    ledc_set_duty_and_update(HAL_PWM_MODE, (ledc_channel_t)ch, duty, 0);
+}
+
+// Fondu matériel sans attente : le CPU n’intervient plus jusqu’à la cible
+static inline void hal_pwm_fade(hal_pwm_channel_t ch, uint32_t duty, uint32_t fade_ms) {
+    ledc_set_fade_time_and_start(HAL_PWM_MODE, (ledc_channel_t)ch, duty, fade_ms, LEDC_FADE_NO_WAIT);
+}
+
+#endif
+#endif
@@ -0,0 +1,91 @@
+#ifndef HAL_TIME_H
+#define HAL_TIME_H
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+
+// ----------------------------------------------------------------------
+//  HAL temps : horloge µs, attentes et minuteries one-shot
+//  ESP32 : esp_timer / esp_rom_delay_us / vTaskDelay
+//  linux : horloge de la carte simulée (réelle ou pilotée, hal_host.h)
+//
+//  hal_cycles() : compteur libre sur 32 bits pour les mesures fines
+//  (cycles CPU sur ESP32, nanosecondes réelles sur linux ; HAL_CYCLES_UNIT)
+// ----------------------------------------------------------------------
+typedef void (*hal_timer_cb_t)(void *arg);
+
+#if CONFIG_IDF_TARGET_LINUX
+
+typedef struct hal_timer *hal_timer_t;
+
+int64_t hal_time_us(void);
+void hal_delay_us(uint32_t us);
+void hal_delay_ms(uint32_t ms);
+hal_timer_t hal_timer_create(hal_timer_cb_t cb, void *arg, const char *name);
+void hal_timer_start_once(hal_timer_t timer, uint64_t delay_us);
+void hal_timer_stop(hal_timer_t timer);
+TickType_t hal_ticks_until(int64_t until_us);
+uint32_t hal_cycles(void);
+#define HAL_CYCLES_UNIT "ns"
+
+#else
+
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "freertos/task.h"
+
+typedef esp_timer_handle_t hal_timer_t;
+
+static inline int64_t hal_time_us(void) {
+    return esp_timer_get_time();
+}
+
+// Attente active (quelques centaines de µs au plus)
+static inline void hal_delay_us(uint32_t us) {
+    esp_rom_delay_us(us);
+}
+
+// Attente qui rend la main aux autres tâches
+static inline void hal_delay_ms(uint32_t ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+// Minuterie one-shot ; cb s’exécute dans la tâche esp_timer
+static inline hal_timer_t hal_timer_create(hal_timer_cb_t cb, void *arg, const char *name) {
+    const esp_timer_create_args_t args = {
+        .callback = cb,
+        .arg = arg,
+        .name = name,
+    };
+    hal_timer_t timer;
+    ESP_ERROR_CHECK(esp_timer_create(&args, &timer));
+    return timer;
+}
+
+static inline void hal_timer_start_once(hal_timer_t timer, uint64_t delay_us) {
+    esp_timer_start_once(timer, delay_us);
+}
+
+// Sans effet si la minuterie est inactive
+static inline void hal_timer_stop(hal_timer_t timer) {
+    esp_timer_stop(timer);
+}
+
+// Attente FreeRTOS jusqu’à until_us, arrondie au tick supérieur
+// (INT64_MAX : sans limite)
+static inline TickType_t hal_ticks_until(int64_t until_us) {
+    if (until_us == INT64_MAX) return portMAX_DELAY;
+    int64_t left = until_us - esp_timer_get_time();
+    const int64_t tick_us = portTICK_PERIOD_MS * 1000LL;
+    return left <= 0 ? 0 : (TickType_t)((left + tick_us - 1) / tick_us);
+}
+
+static inline uint32_t hal_cycles(void) {
+    return esp_cpu_get_cycle_count();
+}
+#define HAL_CYCLES_UNIT "cycles"
+
+#endif
+#endif
@@ -0,0 +1,37 @@
+#ifndef INPUT_LINE_H
+#define INPUT_LINE_H
+#include <stdint.h>
+#include <stdbool.h>
+
+#define INPUT_LINE_MAX       16     // Largeur d’une ligne du LCD
+#define INPUT_LINE_BACKSPACE '*'    // Efface le dernier caractère
+#define INPUT_LINE_ENTER     '#'    // Valide si la ligne est pleine, sinon l’efface
+
+// Options
+#define INPUT_LINE_MASKED      0x01 // Affiche '*' au lieu des caractères
+#define INPUT_LINE_AUTO_SUBMIT 0x02 // Valide dès que la ligne est pleine
+
+typedef enum {
+    INPUT_LINE_IGNORED,    // Touche sans effet (ligne pleine, rien à effacer)
+    INPUT_LINE_CHANGED,    // Contenu modifié
+    INPUT_LINE_SUBMIT,     // Ligne validée : lire input_line_text()
+} input_line_result_t;
+
+// Ligne de saisie à capacité fixe, affichée à (row, col) sur le LCD
+typedef struct {
+    char buf[INPUT_LINE_MAX + 1];
+    uint8_t len;
+    uint8_t capacity;
+    uint8_t row;
+    uint8_t col;
+    uint8_t flags;
+} input_line_t;
+
+void input_line_init(input_line_t *line, uint8_t capacity, uint8_t row, uint8_t col, uint8_t flags);
+input_line_result_t input_line_key(input_line_t *line, char key);
+void input_line_clear(input_line_t *line);
+void input_line_wipe(input_line_t *line);
+const char *input_line_text(const input_line_t *line);
+uint8_t input_line_len(const input_line_t *line);
+
+#endif
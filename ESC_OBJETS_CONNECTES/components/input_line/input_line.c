@@ -0,0 +1,91 @@
+// ======================================================================
+//  Module : input_line.c
+//  Description : Ligne de saisie bornée avec touches d’édition
+//  Fonctionnement :
+//     - Tampon à capacité fixe : les touches en trop sont ignorées,
+//       aucun débordement possible.
+//     - '*' efface le dernier caractère ; '#' valide la ligne si elle
+//       est pleine, sinon l’efface (option : validation automatique).
+//     - Affichage incrémental : seule la case modifiée est réécrite,
+//       une touche coûte un caractère LCD au lieu d’un effacement complet.
+//     - Option de masquage : '*' affiché à la place des caractères.
+// ======================================================================
+
+#include "input_line.h"
+#include "lcd.h"
+
+#define INPUT_LINE_MASK_CHAR '*'
+
+// ----------------------------------------------------------------------
+//  Met à jour une seule case de l’écran
+// ----------------------------------------------------------------------
+static void line_draw(const input_line_t *line, uint8_t pos, char c) {
+    lcd_set_cursor(line->row, line->col + pos);   // Sans commande si déjà en place
+    lcd_putc(c);
+}
+
+void input_line_init(input_line_t *line, uint8_t capacity, uint8_t row, uint8_t col, uint8_t flags) {
+    if (capacity > INPUT_LINE_MAX) capacity = INPUT_LINE_MAX;
+    line->len = 0;
+    line->buf[0] = '\0';
+    line->capacity = capacity;
+    line->row = row;
+    line->col = col;
+    line->flags = flags;
+}
+
+// ----------------------------------------------------------------------
+//  Efface la ligne (contenu et cases affichées)
+// ----------------------------------------------------------------------
+void input_line_clear(input_line_t *line) {
+    for (uint8_t i = 0; i < line->len; i++) line_draw(line, i, ' ');
+    input_line_wipe(line);
+}
+
+// ----------------------------------------------------------------------
+//  Vide le tampon sans toucher à l’écran (après validation d’un code)
+// ----------------------------------------------------------------------
+void input_line_wipe(input_line_t *line) {
+    volatile char *p = line->buf;             // Écriture non supprimée par l’optimiseur
+    for (int i = 0; i <= INPUT_LINE_MAX; i++) p[i] = '\0';
+    line->len = 0;
+}
+
+// ----------------------------------------------------------------------
+//  Traite une touche
+// ----------------------------------------------------------------------
+input_line_result_t input_line_key(input_line_t *line, char key) {
+    bool full = line->len >= line->capacity;
+
+    if (key == INPUT_LINE_BACKSPACE) {
+        if (line->len == 0) return INPUT_LINE_IGNORED;
+        line->buf[--line->len] = '\0';
+        line_draw(line, line->len, ' ');
+        return INPUT_LINE_CHANGED;
+    }
+
+    if (key == INPUT_LINE_ENTER) {
+        if (full) return INPUT_LINE_SUBMIT;
+        if (line->len == 0) return INPUT_LINE_IGNORED;
+        input_line_clear(line);
+        return INPUT_LINE_CHANGED;
+    }
+
+    if (full) return INPUT_LINE_IGNORED;
+
+    line->buf[line->len] = key;
+    line->buf[line->len + 1] = '\0';
+    line_draw(line, line->len, (line->flags & INPUT_LINE_MASKED) ? INPUT_LINE_MASK_CHAR : key);
+    line->len++;
+
+    if ((line->flags & INPUT_LINE_AUTO_SUBMIT) && line->len == line->capacity) return INPUT_LINE_SUBMIT;
+    return INPUT_LINE_CHANGED;
+}
+
+const char *input_line_text(const input_line_t *line) {
+    return line->buf;
+}
+
+uint8_t input_line_len(const input_line_t *line) {
+    return line->len;
+}
@@ -1,8 +1,12 @@
 #ifndef KEYPAD_H
 #define KEYPAD_H
-#include "driver/gpio.h"
+
+// Appelée une fois par touche appuyée (contexte tâche)
+typedef void (*keypad_callback_t)(char key);
 
 void keypad_init(void);
 char keypad_scan(void);
+void keypad_start(keypad_callback_t cb);
+void keypad_wakeup_enable(void);
 
 #endif
\ No newline at end of file
@@ -2,16 +2,25 @@
 //  Commentaires écrits par l'intelligence artificielle
 //  Module : keypad.c
 //  Description : Gestion d’un clavier matriciel 4x4 avec l’ESP32
+//                (broches via hal_gpio.h : ESP32 ou carte simulée)
 //  Fonctionnement : Les 4 lignes sont activées successivement (en sortie).
 //                   Les 4 colonnes sont lues (en entrée) pour détecter
 //                   quelle touche est pressée selon l’intersection.
+//                   En mode événementiel (keypad_start), toutes les lignes
+//                   restent à 0 au repos : un appui fait chuter une colonne,
+//                   ce qui déclenche une interruption ; le balayage n’a
+//                   lieu qu’à ce moment-là, processeur à pleine fréquence
+//                   (verrou CPU_MAX, hal_pm.h).
 // ======================================================================
 
 // Bibliothèques nécessaires
-#include "driver/gpio.h"        // Contrôle des broches GPIO
+#include "hal_gpio.h"          // Broches GPIO (ESP32 ou carte simulée)
+#include "hal_time.h"          // Attentes
+#include "hal_pm.h"            // Pleine fréquence pendant un balayage
 #include "esp_log.h"            // Journalisation (logs pour débogage)
 #include "freertos/FreeRTOS.h"  // Système d’exploitation temps réel
 #include "freertos/task.h"      // Gestion des délais et des tâches
+#include "keypad.h"
 
 // Tag de log (identifie les messages dans la console série)
 static const char *TAG = "keypad";
@@ -32,8 +41,18 @@ char keys[4][4] = {
 // Définition des broches GPIO associées aux lignes et colonnes
 // (adapter selon votre câblage sur la carte ESP32)
 // ----------------------------------------------------------------------
-int rowPins[4] = {13, 19, 14, 27};  // Lignes → sorties
-int colPins[4] = {26, 25, 33, 32};  // Colonnes → entrées
+hal_pin_t rowPins[4] = {13, 19, 14, 27};  // Lignes → sorties
+hal_pin_t colPins[4] = {26, 25, 33, 32};  // Colonnes → entrées
+
+// Période de surveillance du relâchement d’une touche
+#define KEYPAD_RELEASE_POLL_MS 20
+
+// ----------------------------------------------------------------------
+// Mode événementiel : tâche réveillée par interruption
+// ----------------------------------------------------------------------
+static TaskHandle_t s_keypad_task = NULL;
+static keypad_callback_t s_keypad_cb = NULL;
+static hal_pm_lock_t s_pm_lock;
 
 // ----------------------------------------------------------------------
 // Initialisation du clavier
@@ -42,16 +61,13 @@ int colPins[4] = {26, 25, 33, 32};  // Colonnes → entrées
 void keypad_init(void) {
     // Configuration des lignes comme sorties
     for (int i = 0; i < 4; i++) {
-        gpio_reset_pin(rowPins[i]);                 // Réinitialise la broche
-        gpio_set_direction(rowPins[i], GPIO_MODE_OUTPUT); // Définit en sortie
-        gpio_set_level(rowPins[i], 1);              // État haut par défaut
+        hal_gpio_output(rowPins[i]);                // Définit en sortie
+        hal_gpio_set(rowPins[i], 1);                // État haut par défaut
     }
 
     // Configuration des colonnes comme entrées avec résistance pull-up
     for (int i = 0; i < 4; i++) {
-        gpio_reset_pin(colPins[i]);                 // Réinitialise la broche
-        gpio_set_direction(colPins[i], GPIO_MODE_INPUT);  // Définit en entrée
-        gpio_pullup_en(colPins[i]);                 // Active la résistance interne
+        hal_gpio_input(colPins[i], HAL_PULL_UP);    // Entrée, résistance interne
     }
 }
 
@@ -62,25 +78,110 @@ void keypad_init(void) {
 // ----------------------------------------------------------------------
 char keypad_scan(void) {
     for (int row = 0; row < 4; row++) {
-        gpio_set_level(rowPins[row], 0); // Active la ligne courante
+        hal_gpio_set(rowPins[row], 0); // Active la ligne courante
 
         // Vérifie chaque colonne associée
         for (int col = 0; col < 4; col++) {
             // Si une colonne passe à 0, une touche est pressée
-            if (gpio_get_level(colPins[col]) == 0) {
-                vTaskDelay(pdMS_TO_TICKS(100)); // Délai anti-rebond mécanique
+            if (hal_gpio_get(colPins[col]) == 0) {
+                hal_delay_ms(100);              // Délai anti-rebond mécanique
 
                 // Double vérification pour éviter les faux positifs
-                if (gpio_get_level(colPins[col]) == 0) {
-                    gpio_set_level(rowPins[row], 1); // Désactive la ligne
+                if (hal_gpio_get(colPins[col]) == 0) {
+                    hal_gpio_set(rowPins[row], 1); // Désactive la ligne
                     return keys[row][col];           // Retourne le caractère
                 }
             }
         }
 
-        gpio_set_level(rowPins[row], 1); // Remet la ligne à l’état haut
+        hal_gpio_set(rowPins[row], 1); // Remet la ligne à l’état haut
     }
 
     // Si aucune touche n’est pressée
     return '\0';
 }
+
+// ----------------------------------------------------------------------
+// Place toutes les lignes au même niveau
+// (0 = repos en mode événementiel, 1 = prêt pour un balayage)
+// ----------------------------------------------------------------------
+static void keypad_rows_set(int level) {
+    for (int i = 0; i < 4; i++) hal_gpio_set(rowPins[i], level);
+}
+
+// Vrai si au moins une colonne est à 0 (lignes à 0)
+static int keypad_any_pressed(void) {
+    for (int col = 0; col < 4; col++) {
+        if (hal_gpio_get(colPins[col]) == 0) return 1;
+    }
+    return 0;
+}
+
+static void keypad_intr_enable(int enable) {
+    for (int col = 0; col < 4; col++) {
+        hal_gpio_intr_enable(colPins[col], enable);
+    }
+}
+
+// ----------------------------------------------------------------------
+// ISR : une colonne vient de passer à 0
+// Les interruptions sont coupées jusqu’au relâchement de la touche.
+// ----------------------------------------------------------------------
+static void keypad_isr(void *arg) {
+    BaseType_t woken = pdFALSE;
+    for (int col = 0; col < 4; col++) hal_gpio_intr_enable(colPins[col], false);
+    vTaskNotifyGiveFromISR(s_keypad_task, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+// ----------------------------------------------------------------------
+// Tâche du clavier : bloquée tant qu’aucune touche n’est appuyée
+// ----------------------------------------------------------------------
+static void keypad_task(void *arg) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        hal_pm_acquire(s_pm_lock);
+        keypad_rows_set(1);
+        char key = keypad_scan();                  // Balayage + anti-rebond
+        if (key != '\0') s_keypad_cb(key);
+        hal_pm_release(s_pm_lock);
+
+        // Attend le relâchement pour ne pas répéter la touche
+        keypad_rows_set(0);
+        while (keypad_any_pressed()) hal_delay_ms(KEYPAD_RELEASE_POLL_MS);
+
+        keypad_intr_enable(1);
+    }
+}
+
+// ----------------------------------------------------------------------
+// Démarre le mode événementiel
+// cb est appelée (dans la tâche du clavier) une fois par appui.
+// keypad_init() doit avoir été appelée auparavant. La tâche et l’ISR
+// restent sur le cœur de l’appelant.
+// ----------------------------------------------------------------------
+void keypad_start(keypad_callback_t cb) {
+    if (s_keypad_task != NULL) return;
+    s_keypad_cb = cb;
+    s_pm_lock = hal_pm_lock_create(HAL_PM_CPU_MAX, "keypad");
+
+    static StackType_t stack[2048];
+    static StaticTask_t tcb;
+    s_keypad_task = xTaskCreateStaticPinnedToCore(keypad_task, "keypad", sizeof(stack), NULL, 6,
+                                                  stack, &tcb, xPortGetCoreID());
+
+    keypad_rows_set(0);
+    for (int col = 0; col < 4; col++) hal_gpio_isr_add(colPins[col], HAL_EDGE_FALLING, keypad_isr, NULL);
+    keypad_intr_enable(1);
+    ESP_LOGI(TAG, "Clavier en mode interruption");
+}
+
+// ----------------------------------------------------------------------
+// Un appui réveille la puce du sommeil léger (colonnes à 0)
+// À appeler après keypad_start() : les interruptions des colonnes
+// passent alors sur niveau bas, ce que l’ISR tolère puisqu’elle les coupe.
+// ----------------------------------------------------------------------
+void keypad_wakeup_enable(void) {
+    for (int col = 0; col < 4; col++) hal_gpio_wakeup(colPins[col], 0);
+}
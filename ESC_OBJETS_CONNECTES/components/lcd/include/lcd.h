@@ -1,15 +1,23 @@
 #pragma once
-#include "driver/i2c.h"
-#include "esp_err.h"
+#include <stdint.h>
 
 #ifdef __cplusplus
 #endif
 
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
 void lcd_i2c_init(void);
 void lcd_init(void);
 void lcd_clear(void);
 void lcd_set_cursor(int row, int col);
 void lcd_print(const char *str);
+void lcd_putc(char c);
+void lcd_create_char(uint8_t slot, const uint8_t rows[8]);
+void lcd_render_start(int core);          // Envois par une tâche de rendu (après lcd_init)
+void lcd_render_sync(void);               // Attend que tout ce qui a été déposé soit à l’écran
+void lcd_framebuffer(int row, char out[LCD_COLS + 1]);
+uint32_t lcd_framebuffer_version(void);
 
 #ifdef __cplusplus
 #endif
@@ -3,25 +3,42 @@
 //  Module : lcd.c
 //  Description : Contrôle d’un écran LCD 16x2 via un module I2C (PCF8574)
 //  Fonctionnement : 
-//    - Initialise l’interface I2C sur l’ESP32.
+//    - Initialise l’interface I2C (hal_i2c.h : ESP32 ou carte simulée).
 //    - Traduit les commandes HD44780 en signaux I2C.
 //    - Permet d’afficher du texte, effacer l’écran et positionner le curseur.
+//    - Mémorise la position du curseur : un repositionnement sur la
+//      case courante n’envoie aucune commande (mises à jour partielles).
+//    - Garde une copie du texte affiché (lcd_framebuffer), lue par les
+//      tests sans accès à l’écran.
+//    - Tient un verrou APB_MAX (hal_pm.h) pendant chaque échange I2C ;
+//      une chaîne ou une initialisation le garde d’un bout à l’autre pour
+//      que la fréquence ne change pas entre deux caractères.
+//    - Après lcd_render_start(), les commandes et caractères ne sont plus
+//      envoyés par l’appelant mais déposés dans une file sans verrou
+//      (spsc.h) vidée par une tâche de rendu, sur le cœur choisi :
+//      l’appelant (un seul, la boucle du jeu) n’attend plus l’I2C. La
+//      position du curseur et la copie du texte restent tenues du côté
+//      de l’appelant, à jour dès le retour de chaque fonction.
 // ======================================================================
 
 // ----- Dépendances principales -----
 #include "lcd.h"                  // En-tête du module LCD (fonctions publiques)
-#include "driver/i2c.h"           // Pilote I2C de l’ESP-IDF
-#include "freertos/FreeRTOS.h"    // Système d’exploitation temps réel
+#include "hal_i2c.h"             // Bus I2C (ESP32 ou carte simulée)
+#include "hal_time.h"            // Délais en microsecondes / millisecondes
+#include "hal_pm.h"              // Verrou de fréquence pendant les transferts
+#include "spsc.h"                // File vers la tâche de rendu
+#include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "esp_rom_sys.h"          // Délai en microsecondes
 #include "esp_log.h"              // Logs pour débogage
+#include <string.h>
 
 // ----- Paramètres matériels I2C -----
-#define I2C_MASTER_NUM I2C_NUM_0  // Utilisation du bus I2C n°0
 #define SDA_PIN 21                // Broche SDA (données)
 #define SCL_PIN 22                // Broche SCL (horloge)
 #define LCD_ADDR 0x27             // Adresse I2C du module PCF8574
 #define I2C_FREQ_HZ 100000        // Fréquence I2C (100 kHz standard)
+#define LCD_POWER_ON_MS 50        // Délai mini entre mise sous tension et première commande
+#define LCD_QUEUE_FULL_MS 5       // Attente de l’appelant quand la file de rendu est pleine
 
 // ----- Bits de contrôle du PCF8574 -----
 #define PIN_RS 0x01  // Register Select : 0 = commande, 1 = données
@@ -32,36 +49,47 @@
 // Tag de log pour affichage console
 static const char *TAG = "lcd";
 
+// Position courante du curseur (-1 = inconnue)
+static int s_row = -1;
+static int s_col = -1;
+
+// Copie du texte affiché et compteur de modifications
+static char s_fb[LCD_ROWS][LCD_COLS];
+static volatile uint32_t s_fb_version = 0;
+
+// Bus APB à pleine vitesse pendant les transferts (horloge I2C)
+static hal_pm_lock_t s_pm_lock;
+
+// Opérations en attente de la tâche de rendu (NULL : envoi direct)
+typedef enum {
+    LCD_OP_CMD,                   // Commande HD44780
+    LCD_OP_DATA,                  // Caractère (DDRAM ou CGRAM)
+    LCD_OP_CLEAR,                 // Commande "Clear display" et son attente
+} lcd_op_kind_t;
+
+typedef struct {
+    uint8_t kind;                 // lcd_op_kind_t
+    uint8_t value;
+} lcd_op_t;
+
+SPSC_DEFINE(s_ops, lcd_op_t, 128);    // Deux écrans complets et leurs commandes
+static TaskHandle_t s_render_task = NULL;
+static volatile TaskHandle_t s_sync_task = NULL;  // Appelant bloqué dans lcd_render_sync()
+
 // ----------------------------------------------------------------------
 // Initialisation de l’interface I2C
 // Configure l’ESP32 en maître I2C pour communiquer avec le PCF8574
 // ----------------------------------------------------------------------
 void lcd_i2c_init(void) {
-    i2c_config_t conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = SDA_PIN,
-        .scl_io_num = SCL_PIN,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = I2C_FREQ_HZ,
-    };
-
-    // Application de la configuration et activation du pilote
-    ESP_ERROR_CHECK(i2c_param_config(I2C_MASTER_NUM, &conf));
-    ESP_ERROR_CHECK(i2c_driver_install(I2C_MASTER_NUM, conf.mode, 0, 0, 0));
+    hal_i2c_init(SDA_PIN, SCL_PIN, I2C_FREQ_HZ);
+    s_pm_lock = hal_pm_lock_create(HAL_PM_APB_MAX, "lcd");
 }
 
 // ----------------------------------------------------------------------
 // Envoie un octet brut au module LCD via I2C
 // ----------------------------------------------------------------------
 static void lcd_write(uint8_t data) {
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();                  // Création d'une commande I2C
-    i2c_master_start(cmd);                                         // Démarrage de la communication
-    i2c_master_write_byte(cmd, (LCD_ADDR << 1) | I2C_MASTER_WRITE, true); // Adresse + bit écriture
-    i2c_master_write_byte(cmd, data, true);                        // Envoi de la donnée
-    i2c_master_stop(cmd);                                          // Fin de transmission
-    i2c_master_cmd_begin(I2C_MASTER_NUM, cmd, pdMS_TO_TICKS(100)); // Exécution de la commande
-    i2c_cmd_link_delete(cmd);                                      // Libération
+    hal_i2c_write(LCD_ADDR, &data, 1);    // START, adresse, donnée, STOP
 }
 
 // ----------------------------------------------------------------------
@@ -70,9 +98,9 @@ static void lcd_write(uint8_t data) {
 // ----------------------------------------------------------------------
 static void lcd_pulse(uint8_t data) {
     lcd_write(data | PIN_EN);      // Met EN à 1
-    esp_rom_delay_us(600);         // Attente (~0.6 ms)
+    hal_delay_us(600);         // Attente (~0.6 ms)
     lcd_write(data & ~PIN_EN);     // Met EN à 0
-    esp_rom_delay_us(600);
+    hal_delay_us(600);
 }
 
 // ----------------------------------------------------------------------
@@ -87,49 +115,90 @@ static void lcd_send(uint8_t value, uint8_t mode) {
     lcd_pulse(low  | mode | PIN_BL);      // Puis des 4 bits bas
 }
 
+// ----------------------------------------------------------------------
+// Exécute une opération sur le bus (tâche de rendu, ou appelant avant
+// lcd_render_start)
+// ----------------------------------------------------------------------
+static void lcd_exec(lcd_op_t op) {
+    hal_pm_acquire(s_pm_lock);
+    if (op.kind == LCD_OP_DATA) {
+        lcd_send(op.value, PIN_RS);       // mode=RS → écriture de texte
+        hal_delay_us(600);
+    } else {
+        lcd_send(op.value, 0x00);         // mode=0 → commande
+    }
+    hal_pm_release(s_pm_lock);
+    if (op.kind != LCD_OP_DATA) hal_delay_ms(2);    // Petit délai de traitement
+    if (op.kind == LCD_OP_CLEAR) hal_delay_ms(5);   // Attente complète du cycle
+}
+
+// ----------------------------------------------------------------------
+// Envoie tout de suite, ou dépose pour la tâche de rendu
+// ----------------------------------------------------------------------
+static void lcd_submit(uint8_t kind, uint8_t value) {
+    lcd_op_t op = {.kind = kind, .value = value};
+    if (s_render_task == NULL) {
+        lcd_exec(op);
+        return;
+    }
+    while (!spsc_push(&s_ops, &op)) hal_delay_ms(LCD_QUEUE_FULL_MS);
+    xTaskNotifyGive(s_render_task);
+}
+
 // ----------------------------------------------------------------------
 // Envoie une commande de contrôle (ex: effacer, déplacer curseur)
 // ----------------------------------------------------------------------
 static void lcd_cmd(uint8_t cmd) {
-    lcd_send(cmd, 0x00);                  // mode=0 → commande
-    vTaskDelay(pdMS_TO_TICKS(2));         // Petit délai de traitement
+    lcd_submit(LCD_OP_CMD, cmd);
 }
 
 // ----------------------------------------------------------------------
 // Envoie une donnée affichable (caractère ASCII)
 // ----------------------------------------------------------------------
 static void lcd_data(uint8_t data) {
-    lcd_send(data, PIN_RS);               // mode=RS → écriture de texte
-    esp_rom_delay_us(600);
+    lcd_submit(LCD_OP_DATA, data);
+    if (s_row >= 0 && s_col >= 0 && s_col < LCD_COLS && s_fb[s_row][s_col] != (char)data) {
+        s_fb[s_row][s_col] = data;
+        s_fb_version++;
+    }
+    if (s_col >= 0) s_col++;              // Incrément automatique du LCD
 }
 
 // ----------------------------------------------------------------------
 // Efface l’écran LCD
 // ----------------------------------------------------------------------
 void lcd_clear(void) {
-    lcd_cmd(0x01);                        // Commande "Clear display"
-    vTaskDelay(pdMS_TO_TICKS(5));         // Attente complète du cycle
+    lcd_submit(LCD_OP_CLEAR, 0x01);       // Commande "Clear display"
+    s_row = 0;                            // Curseur ramené au début
+    s_col = 0;
+    memset(s_fb, ' ', sizeof(s_fb));
+    s_fb_version++;
 }
 
 // ----------------------------------------------------------------------
 // Initialise le LCD en mode 4 bits selon la séquence HD44780
 // ----------------------------------------------------------------------
 void lcd_init(void) {
-    vTaskDelay(pdMS_TO_TICKS(50));        // Attente après mise sous tension
+    // Attente après mise sous tension (40 ms au moins) : l’horloge part
+    // après le bootloader, le temps déjà écoulé est donc acquis
+    int64_t since_boot_ms = hal_time_us() / 1000;
+    if (since_boot_ms < LCD_POWER_ON_MS) hal_delay_ms(LCD_POWER_ON_MS - since_boot_ms);
 
     // Séquence d’initialisation 8 bits → 4 bits
+    hal_pm_acquire(s_pm_lock);
     lcd_write(0x30);
-    vTaskDelay(pdMS_TO_TICKS(5));
+    hal_delay_ms(5);
     lcd_write(0x30);
-    esp_rom_delay_us(600);
+    hal_delay_us(600);
     lcd_write(0x20);                      // Passage en mode 4 bits
-    vTaskDelay(pdMS_TO_TICKS(5));
+    hal_delay_ms(5);
 
     // Configuration du mode d’affichage
     lcd_cmd(0x28);                        // 4 bits, 2 lignes, police 5x8
     lcd_cmd(0x0C);                        // Écran ON, curseur OFF
     lcd_cmd(0x06);                        // Incrément automatique du curseur
     lcd_clear();                          // Efface tout
+    hal_pm_release(s_pm_lock);
 
     ESP_LOGI(TAG, "LCD initialisé");
 }
@@ -140,12 +209,100 @@ void lcd_init(void) {
 // ----------------------------------------------------------------------
 void lcd_set_cursor(int row, int col) {
     static const uint8_t offsets[] = {0x00, 0x40}; // Adresse de début ligne
+    if (row == s_row && col == s_col) return;      // Déjà en place
     lcd_cmd(0x80 | (col + offsets[row]));          // Commande Set DDRAM Address
+    s_row = row;
+    s_col = col;
 }
 
 // ----------------------------------------------------------------------
 // Affiche une chaîne de caractères sur le LCD
 // ----------------------------------------------------------------------
 void lcd_print(const char *str) {
+    hal_pm_acquire(s_pm_lock);
     while (*str) lcd_data(*str++);        // Envoie chaque caractère
+    hal_pm_release(s_pm_lock);
+}
+
+// ----------------------------------------------------------------------
+// Affiche un seul caractère à la position du curseur
+// ----------------------------------------------------------------------
+void lcd_putc(char c) {
+    lcd_data(c);
+}
+
+// ----------------------------------------------------------------------
+// Définit un caractère personnalisé (CGRAM)
+// slot = 0..7, affiché avec le code slot + 8 ('\0' termine les chaînes)
+// rows = 8 lignes de 5 pixels (bits 4..0)
+// ----------------------------------------------------------------------
+void lcd_create_char(uint8_t slot, const uint8_t rows[8]) {
+    hal_pm_acquire(s_pm_lock);
+    lcd_cmd(0x40 | ((slot & 0x07) << 3));     // Commande Set CGRAM Address
+    s_row = -1;                               // Écritures hors de la DDRAM
+    for (int i = 0; i < 8; i++) lcd_data(rows[i] & 0x1F);
+    lcd_cmd(0x80);                            // Retour en DDRAM
+    hal_pm_release(s_pm_lock);
+    s_row = 0;
+    s_col = 0;
+}
+
+// ----------------------------------------------------------------------
+// Tâche de rendu : vide la file par rafales, bus à pleine vitesse
+// ----------------------------------------------------------------------
+static void lcd_render_task(void *arg) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        hal_pm_acquire(s_pm_lock);
+        lcd_op_t op;
+        while (spsc_pop(&s_ops, &op)) lcd_exec(op);
+        hal_pm_release(s_pm_lock);
+
+        // File vide : l’appelant bloqué n’a rien pu déposer entre-temps
+        TaskHandle_t waiter = s_sync_task;
+        if (waiter != NULL) {
+            s_sync_task = NULL;
+            xTaskNotifyGive(waiter);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+// Confie les envois à une tâche sur le cœur core (tskNO_AFFINITY : aucun)
+// Ensuite, une seule tâche appelle les fonctions d’écriture.
+// ----------------------------------------------------------------------
+void lcd_render_start(int core) {
+    if (s_render_task != NULL) return;
+    static StackType_t stack[3072];
+    static StaticTask_t tcb;
+    s_render_task = xTaskCreateStaticPinnedToCore(lcd_render_task, "lcd", sizeof(stack), NULL, 5,
+                                                  stack, &tcb, core);
+    ESP_LOGI(TAG, "Rendu confié à une tâche");
+}
+
+// ----------------------------------------------------------------------
+// Attend que la tâche de rendu ait envoyé tout ce qui a été déposé
+// (par exemple pour horodater l’invite une fois réellement affichée)
+// ----------------------------------------------------------------------
+void lcd_render_sync(void) {
+    if (s_render_task == NULL) return;    // Envois directs : déjà fait
+    s_sync_task = xTaskGetCurrentTaskHandle();
+    xTaskNotifyGive(s_render_task);       // Un passage de plus, même file vide
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+// ----------------------------------------------------------------------
+// Texte d’une ligne tel qu’affiché ; caractères personnalisés → '?'
+// ----------------------------------------------------------------------
+void lcd_framebuffer(int row, char out[LCD_COLS + 1]) {
+    for (int i = 0; i < LCD_COLS; i++) {
+        char c = s_fb[row][i];
+        out[i] = (c >= 0x20 && c < 0x7F) ? c : '?';
+    }
+    out[LCD_COLS] = '\0';
+}
+
+// Change à chaque modification du texte affiché
+uint32_t lcd_framebuffer_version(void) {
+    return s_fb_version;
 }
@@ -1,16 +1,32 @@
 #ifndef LED_H
 #define LED_H
-#include "driver/gpio.h"
+#include "hal_gpio.h"
+#include "hal_pwm.h"
+
+// Masques des LEDs (un bit par LED dans l’état global)
+#define LED_EP1 (1u << 0)
+#define LED_EP2 (1u << 1)
+#define LED_ERR (1u << 2)
+#define LED_ALL (LED_EP1 | LED_EP2 | LED_ERR)
+
 typedef struct {
-    gpio_num_t gpio;
-    uint8_t state;
+    hal_pin_t gpio;
+    uint8_t mask;            // Bit de la LED (LED_EP1, LED_EP2, LED_ERR)
+    hal_pwm_channel_t channel; // Canal PWM (LEDC) utilisé pour les effets
+    uint8_t pwm;             // 1 si la broche est pilotée par le LEDC
 } Led;
 void leds_init(void);
 void led_toggle(Led *led);
 void led_on(Led *led);
 void led_off(Led *led);
+int led_is_on(const Led *led);
+void leds_set(uint32_t on_mask, uint32_t off_mask);
+void leds_write(uint32_t on_mask, uint32_t off_mask);
+uint32_t leds_state(void);
 Led* get_led_ep1(void);
 Led* get_led_ep2(void);
 Led* get_led_err(void);
 void leds_morse_sequence(const char *message);
+void leds_morse_start(const char *message);
+void leds_morse_set_speed(unsigned wpm, unsigned farnsworth_wpm);
 #endif
\ No newline at end of file
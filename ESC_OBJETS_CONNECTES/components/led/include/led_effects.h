@@ -0,0 +1,38 @@
+#ifndef LED_EFFECTS_H
+#define LED_EFFECTS_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "led.h"
+#include "morse.h"
+
+// Étape d’un effet : fondu matériel vers une luminosité, puis maintien
+typedef struct {
+    uint8_t brightness;    // Luminosité cible (0..255)
+    uint16_t fade_ms;      // Durée du fondu (0 = changement immédiat)
+    uint16_t hold_ms;      // Maintien une fois la cible atteinte
+} led_keyframe_t;
+
+// Effet déclaratif : suite d’étapes, éventuellement répétée
+typedef struct {
+    const led_keyframe_t *frames;
+    uint8_t count;
+    bool loop;             // true = reprend à la première étape (durée totale > 0)
+} led_effect_t;
+
+// Effets prédéfinis
+extern const led_effect_t LED_EFFECT_BREATHE;  // Respiration lente
+extern const led_effect_t LED_EFFECT_PULSE;    // Battement court
+extern const led_effect_t LED_EFFECT_SUCCESS;  // Montée douce puis allumée
+extern const led_effect_t LED_EFFECT_ERROR;    // Trois éclairs puis éteinte
+
+void led_effects_init(void);
+void led_effect_start(Led *led, const led_effect_t *effect);
+void led_effect_blink(Led *led, uint16_t on_ms, uint16_t off_ms, uint16_t count);
+void led_effect_morse(Led *led, const morse_timing_t *timing, const char *message);
+void led_effect_wait(Led *led);
+void led_effect_stop(Led *led);
+void led_set_brightness(Led *led, uint8_t brightness);
+uint32_t led_effects_busy(void);
+void led_effects_release(uint32_t mask);
+
+#endif
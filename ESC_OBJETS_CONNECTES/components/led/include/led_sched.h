@@ -0,0 +1,30 @@
+#ifndef LED_SCHED_H
+#define LED_SCHED_H
+#include <stdint.h>
+
+// Valeur de retour d’une étape : l’effet est terminé
+#define LED_SCHED_DONE INT64_MIN
+
+typedef struct led_sched_entry led_sched_entry_t;
+
+// Étape d’un effet : reçoit l’échéance prévue (et non l’heure de réveil),
+// retourne l’échéance suivante en µs ou LED_SCHED_DONE.
+typedef int64_t (*led_sched_step_t)(led_sched_entry_t *entry, int64_t deadline_us);
+
+struct led_sched_entry {
+    led_sched_entry_t *next;   // Chaînage dans l’emplacement de la roue
+    int64_t deadline_us;       // Échéance absolue (hal_time_us)
+    led_sched_step_t step;
+    uint8_t slot;              // Emplacement occupé dans la roue
+    uint8_t armed;             // 1 si présent dans la roue
+};
+
+void led_sched_init(void);
+void led_sched_lock(void);
+void led_sched_unlock(void);
+
+// À appeler avec le verrou pris
+void led_sched_start(led_sched_entry_t *entry, int64_t deadline_us);
+void led_sched_cancel(led_sched_entry_t *entry);
+
+#endif
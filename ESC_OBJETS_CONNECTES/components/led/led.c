@@ -9,9 +9,10 @@
 // ======================================================================
 
 #include "led.h"
-#include "driver/gpio.h"
+#include "led_effects.h"           // Effets PWM (fondus matériels LEDC)
+#include "hal_gpio.h"              // Sorties (ESP32 ou carte simulée)
 #include "esp_log.h"
-#include <ctype.h>                 // Pour toupper()
+#include "morse.h"                 // Table Morse et calcul des durées
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -26,40 +27,25 @@ static const char *TAG = "led.c";
 #define LED_GPIO_ERR 2   // LED rouge (erreur ou échec)
 
 // ----------------------------------------------------------------------
-//  Durées en millisecondes pour les signaux Morse
+//  Définition des objets LED : structure Led définie dans led.h
 // ----------------------------------------------------------------------
-#define DOT 200            // Point : 200 ms
-#define DASH (3 * DOT)     // Tiret : 600 ms
-#define SYMBOL_SPACE DOT   // Pause entre symboles d'une même lettre
-#define LETTER_SPACE (5 * DOT) // Pause entre lettres
-#define WORD_SPACE (7 * DOT)   // Pause entre mots
+static Led led_ep1 = {LED_GPIO_EP1, LED_EP1, 0, 0};
+static Led led_ep2 = {LED_GPIO_EP2, LED_EP2, 1, 0};
+static Led led_err = {LED_GPIO_ERR, LED_ERR, 2, 0};
 
 // ----------------------------------------------------------------------
-//  Définition des objets LED : structure Led définie dans led.h
+//  État de toutes les LEDs (un bit par LED) et conversion masque LED →
+//  masque GPIO, précalculée pour chaque combinaison (toutes les LEDs
+//  sont sur des GPIO < 32, donc dans un seul registre de sortie).
 // ----------------------------------------------------------------------
-static Led led_ep1 = {LED_GPIO_EP1, 0};
-static Led led_ep2 = {LED_GPIO_EP2, 0};
-static Led led_err = {LED_GPIO_ERR, 0};
+static volatile uint32_t s_led_state = 0;
+static uint32_t s_gpio_mask[LED_ALL + 1];
+static portMUX_TYPE s_led_mux = portMUX_INITIALIZER_UNLOCKED;
 
 // ----------------------------------------------------------------------
-//  Table du code Morse (lettre → motif . et -)
+//  Durées Morse courantes (lues par l’effet Morse pendant la lecture)
 // ----------------------------------------------------------------------
-typedef struct {
-    char letter;
-    const char *pattern;
-} morse_t;
-
-// Cette constante a été générée par IA pour représenter l’alphabet Morse complet.
-static const morse_t morse_table[] = {
-    {'A', ".-"}, {'B', "-..."}, {'C', "-.-."}, {'D', "-.."}, {'E', "."},
-    {'F', "..-."}, {'G', "--."}, {'H', "...."}, {'I', ".."}, {'J', ".---"},
-    {'K', "-.-"}, {'L', ".-.."}, {'M', "--"}, {'N', "-."}, {'O', "---"},
-    {'P', ".--."}, {'Q', "--.-"}, {'R', ".-."}, {'S', "..."}, {'T', "-"},
-    {'U', "..-"}, {'V', "...-"}, {'W', ".--"}, {'X', "-..-"}, {'Y', "-.--"},
-    {'Z', "--.."},
-    {'1', ".----"}, {'2', "..---"}, {'3', "...--"}, {'4', "....-"}, {'5', "....."},
-    {'6', "-...."}, {'7', "--..."}, {'8', "---.."}, {'9', "----."}, {'0', "-----"}
-};
+static morse_timing_t s_morse_timing;
 
 // ----------------------------------------------------------------------
 //  Initialisation de toutes les LEDs (sorties GPIO)
@@ -67,88 +53,95 @@ static const morse_t morse_table[] = {
 void leds_init(void) {
     ESP_LOGI(TAG, "Initialisation de toutes les LEDs...");
 
-    gpio_reset_pin(led_ep1.gpio);
-    gpio_set_direction(led_ep1.gpio, GPIO_MODE_OUTPUT);
+    hal_gpio_output(led_ep1.gpio);
+    hal_gpio_output(led_ep2.gpio);
+    hal_gpio_output(led_err.gpio);
 
-    gpio_reset_pin(led_ep2.gpio);
-    gpio_set_direction(led_ep2.gpio, GPIO_MODE_OUTPUT);
+    // Table masque LED → masque GPIO
+    const Led *leds[] = {&led_ep1, &led_ep2, &led_err};
+    for (uint32_t m = 0; m <= LED_ALL; m++) {
+        s_gpio_mask[m] = 0;
+        for (int i = 0; i < 3; i++) {
+            if (m & leds[i]->mask) s_gpio_mask[m] |= 1u << leds[i]->gpio;
+        }
+    }
 
-    gpio_reset_pin(led_err.gpio);
-    gpio_set_direction(led_err.gpio, GPIO_MODE_OUTPUT);
+    // Vitesse Morse par défaut
+    morse_timing_init(&s_morse_timing, MORSE_DEFAULT_WPM, MORSE_DEFAULT_FARNSWORTH_WPM);
+
+    led_effects_init();                 // Canaux LEDC et ordonnanceur des effets
 }
 
 // ----------------------------------------------------------------------
-//  Allume une LED donnée
+//  Change la vitesse Morse
+//  - wpm            : vitesse des caractères en mots par minute
+//  - farnsworth_wpm : vitesse globale (0 = espacement standard)
 // ----------------------------------------------------------------------
-void led_on(Led *led) {
-    led->state = 1;
-    gpio_set_level(led->gpio, 1);
-    ESP_LOGI(TAG, "LED GPIO %d ON", led->gpio);
+void leds_morse_set_speed(unsigned wpm, unsigned farnsworth_wpm) {
+    morse_timing_init(&s_morse_timing, wpm, farnsworth_wpm);
+    ESP_LOGI(TAG, "Vitesse Morse : %u WPM (Farnsworth %u), point = %lu us",
+             wpm, farnsworth_wpm, (unsigned long)s_morse_timing.dot_us);
 }
 
 // ----------------------------------------------------------------------
-//  Éteint une LED donnée
+//  Écrit plusieurs LEDs d’un coup, sans toucher aux effets en cours
+//  Une écriture dans GPIO_OUT_W1TS (allumage) et une dans GPIO_OUT_W1TC
+//  (extinction), via hal_gpio_write_mask() : les LEDs d’un même masque
+//  changent au même instant.
+//  Utilisé tel quel par l’ordonnanceur des effets à chaque front.
 // ----------------------------------------------------------------------
-void led_off(Led *led) {
-    led->state = 0;
-    gpio_set_level(led->gpio, 0);
-    ESP_LOGI(TAG, "LED GPIO %d OFF", led->gpio);
+void leds_write(uint32_t on_mask, uint32_t off_mask) {
+    on_mask &= LED_ALL;
+    off_mask &= LED_ALL & ~on_mask;
+
+    portENTER_CRITICAL_SAFE(&s_led_mux);
+    hal_gpio_write_mask(s_gpio_mask[on_mask], s_gpio_mask[off_mask]);
+    s_led_state = (s_led_state | on_mask) & ~off_mask;
+    portEXIT_CRITICAL_SAFE(&s_led_mux);
 }
 
 // ----------------------------------------------------------------------
-//  (Réservé) — fonction vide pour extensions futures
+//  Change plusieurs LEDs de façon synchrone (masques LED_EP1 | ...)
+//  Les effets en cours sur ces LEDs sont arrêtés au préalable.
 // ----------------------------------------------------------------------
-void led_morse_sequence(Led *led) {
-    // Cette fonction pourrait être utilisée pour déclencher une séquence prédéfinie
+void leds_set(uint32_t on_mask, uint32_t off_mask) {
+    uint32_t busy = led_effects_busy() & (on_mask | off_mask);
+    if (busy) led_effects_release(busy);       // Reprend le contrôle tout-ou-rien
+    leds_write(on_mask, off_mask);
+    ESP_LOGD(TAG, "LEDs +0x%lx -0x%lx", (unsigned long)on_mask, (unsigned long)off_mask);
 }
 
 // ----------------------------------------------------------------------
-//  Bascule l’état d’une LED (si ON → OFF, si OFF → ON)
+//  État courant de toutes les LEDs (un bit par LED)
 // ----------------------------------------------------------------------
-void led_toggle(Led *led) {
-    led->state = !led->state;
-    gpio_set_level(led->gpio, led->state);
-    ESP_LOGI(TAG, "LED GPIO %d %s", led->gpio, led->state ? "ON" : "OFF");
+uint32_t leds_state(void) {
+    return s_led_state;
+}
+
+int led_is_on(const Led *led) {
+    return (s_led_state & led->mask) != 0;
 }
 
 // ----------------------------------------------------------------------
-//  Fonction écrite par l'intelligence artificielle
-//  Fonction interne : clignotement d’un message en code Morse
-// ----------------------------------------------------------------------
-//  Pour chaque caractère du texte :
-//   - conversion en majuscule
-//   - recherche du motif (. ou -)
-//   - allumage/temporisation/extinction selon la durée correspondante
+//  Allume une LED donnée
 // ----------------------------------------------------------------------
-static void morse_flash(Led *led, const char *text) {
-    for (int i = 0; text[i] != '\0'; i++) {
-        char c = toupper(text[i]); // Normalisation en majuscule
+void led_on(Led *led) {
+    leds_set(led->mask, 0);
+}
 
-        // Espace entre les mots
-        if (c == ' ') {
-            vTaskDelay(pdMS_TO_TICKS(WORD_SPACE));
-            continue;
-        }
+// ----------------------------------------------------------------------
+//  Éteint une LED donnée
+// ----------------------------------------------------------------------
+void led_off(Led *led) {
+    leds_set(0, led->mask);
+}
 
-        // Recherche du caractère dans la table Morse
-        for (int j = 0; j < sizeof(morse_table) / sizeof(morse_t); j++) {
-            if (morse_table[j].letter == c) {
-                const char *pattern = morse_table[j].pattern;
-
-                // Parcourt du motif (. ou -)
-                for (int k = 0; pattern[k] != '\0'; k++) {
-                    led_on(led);
-                    vTaskDelay(pdMS_TO_TICKS(pattern[k] == '.' ? DOT : DASH));
-                    led_off(led);
-                    vTaskDelay(pdMS_TO_TICKS(SYMBOL_SPACE)); // Pause entre symboles
-                }
-
-                // Pause entre lettres
-                vTaskDelay(pdMS_TO_TICKS(LETTER_SPACE));
-                break;
-            }
-        }
-    }
+// ----------------------------------------------------------------------
+//  Bascule l’état d’une LED (si ON → OFF, si OFF → ON)
+// ----------------------------------------------------------------------
+void led_toggle(Led *led) {
+    if (led_is_on(led)) leds_set(0, led->mask);
+    else leds_set(led->mask, 0);
 }
 
 // ----------------------------------------------------------------------
@@ -158,10 +151,20 @@ static void morse_flash(Led *led, const char *text) {
 void leds_morse_sequence(const char *message) {
     ESP_LOGI(TAG, "Début de la séquence Morse : %s", message);
     Led *led = get_led_ep2();           // Utilise la LED verte pour le signal
-    morse_flash(led, message);          // Exécution de la séquence
+    led_effect_morse(led, &s_morse_timing, message);
+    led_effect_wait(led);               // Attend la fin de la séquence
     ESP_LOGI(TAG, "Séquence Morse terminée.");
 }
 
+// ----------------------------------------------------------------------
+//  Fonction publique : lance une séquence Morse sans attendre sa fin
+//  Les fronts sont planifiés par l’ordonnanceur des effets.
+// ----------------------------------------------------------------------
+void leds_morse_start(const char *message) {
+    ESP_LOGI(TAG, "Séquence Morse en arrière-plan : %s", message);
+    led_effect_morse(get_led_ep2(), &s_morse_timing, message);
+}
+
 // ----------------------------------------------------------------------
 //  Accès aux objets LED (interface publique du module)
 // ----------------------------------------------------------------------
@@ -0,0 +1,410 @@
+// ======================================================================
+//  Module : led_effects.c
+//  Description : Effets lumineux (étapes LEDC, clignotement, Morse)
+//  Fonctionnement :
+//     - Chaque LED possède un emplacement d’effet ; lancer un effet
+//       remplace celui en cours sur la même LED.
+//     - Les étapes déclaratives (luminosité, fondu, maintien) sont
+//       exécutées par le LEDC : le fondu est matériel, le CPU n’est
+//       réveillé qu’en fin d’étape.
+//     - Le clignotement et le Morse pilotent la broche en tout-ou-rien.
+//     - Toutes les échéances passent par l’ordonnanceur unique
+//       (led_sched.c) : aucune tâche ni minuterie par effet.
+//     - Hors effet, la broche est rendue au GPIO : led_on()/led_off()
+//       gardent leur comportement tout-ou-rien.
+//     - Tant qu’une LED est en effet ou en PWM, deux verrous (hal_pm.h)
+//       gardent le bus APB à 80 MHz (fréquence du LEDC) et interdisent
+//       le sommeil léger (fronts Morse à l’heure) ; ils sont rendus avec
+//       la dernière LED revenue au tout-ou-rien. Un effet sans boucle
+//       qui finit allumé ou éteint y revient de lui-même.
+// ======================================================================
+
+#include "led_effects.h"
+#include "led_sched.h"
+#include "hal_pwm.h"               // Canaux LEDC (ESP32 ou carte simulée)
+#include "hal_time.h"
+#include "hal_pm.h"                // Verrous de fréquence et de sommeil
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "led_effects";
+
+// ----------------------------------------------------------------------
+//  Paramètres du PWM
+// ----------------------------------------------------------------------
+#define FX_DUTY_MAX    HAL_PWM_DUTY_MAX
+#define FX_FREQ_HZ     5000        // Au-delà de la persistance rétinienne
+#define FX_LED_COUNT   3
+#define FX_MORSE_MAX   32          // Longueur maximale d’un message Morse
+
+// ----------------------------------------------------------------------
+//  Effets prédéfinis
+// ----------------------------------------------------------------------
+static const led_keyframe_t breathe_frames[] = {
+    {255, 1500, 0},
+    {0,   1500, 300},
+};
+const led_effect_t LED_EFFECT_BREATHE = {breathe_frames, 2, true};
+
+static const led_keyframe_t pulse_frames[] = {
+    {255, 80,  0},
+    {0,   400, 500},
+};
+const led_effect_t LED_EFFECT_PULSE = {pulse_frames, 2, true};
+
+static const led_keyframe_t success_frames[] = {
+    {255, 800, 0},
+};
+const led_effect_t LED_EFFECT_SUCCESS = {success_frames, 1, false};
+
+static const led_keyframe_t error_frames[] = {
+    {255, 0, 120}, {0, 0, 120},
+    {255, 0, 120}, {0, 0, 120},
+    {255, 0, 120}, {0, 300, 0},
+};
+const led_effect_t LED_EFFECT_ERROR = {error_frames, 6, false};
+
+// ----------------------------------------------------------------------
+//  État de l’effet en cours sur une LED
+// ----------------------------------------------------------------------
+typedef enum {
+    FX_NONE,
+    FX_KEYFRAMES,
+    FX_BLINK,
+    FX_MORSE,
+} fx_kind_t;
+
+typedef struct {
+    led_sched_entry_t entry;       // En tête : conversion entrée → emplacement
+    Led *led;
+    fx_kind_t kind;
+    uint8_t brightness;            // Luminosité PWM actuellement appliquée
+    TaskHandle_t waiter;           // Tâche bloquée dans led_effect_wait()
+    union {
+        struct {
+            const led_effect_t *effect;
+            uint8_t frame;         // Prochaine étape à jouer
+            bool loop;
+        } kf;
+        struct {
+            uint32_t on_us;
+            uint32_t off_us;
+            uint16_t remaining;    // Cycles restants (0 = infini)
+        } blink;
+        struct {
+            morse_iter_t it;
+            char text[FX_MORSE_MAX + 1];
+        } morse;
+    };
+} fx_slot_t;
+
+static fx_slot_t s_slots[FX_LED_COUNT];
+static bool s_ready = false;
+static volatile uint32_t s_busy = 0;        // LEDs avec effet ou broche PWM
+static hal_pm_lock_t s_pm_apb, s_pm_awake;
+static bool s_pm_held = false;
+
+// ----------------------------------------------------------------------
+//  Conversions et routage de la broche
+// ----------------------------------------------------------------------
+static uint32_t fx_duty(uint8_t brightness) {
+    return ((uint32_t)brightness * FX_DUTY_MAX) / 255;
+}
+
+static fx_slot_t *fx_slot(Led *led) {
+    return &s_slots[led->channel];
+}
+
+// Verrous tenus si et seulement si une LED est occupée
+static void fx_pm_sync(void) {
+    if (s_busy && !s_pm_held) {
+        hal_pm_acquire(s_pm_apb);
+        hal_pm_acquire(s_pm_awake);
+        s_pm_held = true;
+    } else if (!s_busy && s_pm_held) {
+        hal_pm_release(s_pm_awake);
+        hal_pm_release(s_pm_apb);
+        s_pm_held = false;
+    }
+}
+
+// Tient à jour le masque des LEDs qui ne sont pas en simple tout-ou-rien
+static void fx_update_busy(fx_slot_t *slot) {
+    if (slot->kind != FX_NONE || slot->led->pwm) s_busy |= slot->led->mask;
+    else s_busy &= ~(uint32_t)slot->led->mask;
+    fx_pm_sync();
+}
+
+// Connecte la broche à la sortie du canal LEDC
+static void fx_attach(Led *led) {
+    if (led->pwm) return;
+    hal_pwm_attach(led->channel, led->gpio);
+    led->pwm = 1;
+    s_busy |= led->mask;
+    fx_pm_sync();
+}
+
+// Rend la broche au registre de sortie GPIO (niveau = état de la LED)
+static void fx_detach(Led *led) {
+    if (!led->pwm) return;
+    hal_pwm_detach(led->gpio);
+    led->pwm = 0;
+    fx_update_busy(fx_slot(led));
+}
+
+// Niveau tout-ou-rien sans journalisation (appelé à chaque front)
+static void fx_set_level(Led *led, uint8_t level) {
+    if (level) leds_write(led->mask, 0);
+    else leds_write(0, led->mask);
+    fx_detach(led);
+}
+
+// ----------------------------------------------------------------------
+//  Fin et annulation (appelées avec le verrou de l’ordonnanceur pris)
+// ----------------------------------------------------------------------
+static void fx_finish(fx_slot_t *slot) {
+    slot->kind = FX_NONE;
+    fx_update_busy(slot);
+    if (slot->waiter != NULL) {
+        xTaskNotifyGive(slot->waiter);
+        slot->waiter = NULL;
+    }
+}
+
+static void fx_cancel(fx_slot_t *slot) {
+    led_sched_cancel(&slot->entry);
+    if (slot->kind != FX_NONE) fx_finish(slot);
+}
+
+// ----------------------------------------------------------------------
+//  Étapes déclaratives : une échéance par étape (fondu + maintien)
+// ----------------------------------------------------------------------
+static int64_t fx_keyframe_step(led_sched_entry_t *entry, int64_t deadline_us) {
+    fx_slot_t *slot = (fx_slot_t *)entry;
+    const led_effect_t *effect = slot->kf.effect;
+    Led *led = slot->led;
+
+    if (slot->kf.frame >= effect->count) {
+        if (!slot->kf.loop) {
+            // Allumée ou éteinte : la broche revient au GPIO et les verrous
+            // sont rendus ; seule une luminosité partielle garde le PWM
+            if (slot->brightness == 0 || slot->brightness == 255) fx_set_level(led, slot->brightness != 0);
+            fx_finish(slot);
+            return LED_SCHED_DONE;
+        }
+        slot->kf.frame = 0;
+    }
+
+    const led_keyframe_t *kf = &effect->frames[slot->kf.frame++];
+    if (kf->fade_ms > 0 && kf->brightness != slot->brightness) {
+        hal_pwm_fade(led->channel, fx_duty(kf->brightness), kf->fade_ms);
+    } else {
+        hal_pwm_set(led->channel, fx_duty(kf->brightness));
+    }
+    slot->brightness = kf->brightness;
+
+    return deadline_us + ((int64_t)kf->fade_ms + kf->hold_ms) * 1000;
+}
+
+// ----------------------------------------------------------------------
+//  Clignotement : une échéance par front
+// ----------------------------------------------------------------------
+static int64_t fx_blink_step(led_sched_entry_t *entry, int64_t deadline_us) {
+    fx_slot_t *slot = (fx_slot_t *)entry;
+    Led *led = slot->led;
+
+    if (!led_is_on(led)) {
+        fx_set_level(led, 1);
+        return deadline_us + slot->blink.on_us;
+    }
+
+    fx_set_level(led, 0);
+    if (slot->blink.remaining > 0 && --slot->blink.remaining == 0) {
+        fx_finish(slot);
+        return LED_SCHED_DONE;
+    }
+    return deadline_us + slot->blink.off_us;
+}
+
+// ----------------------------------------------------------------------
+//  Morse : l’itérateur fournit chaque front et sa durée
+// ----------------------------------------------------------------------
+static int64_t fx_morse_step(led_sched_entry_t *entry, int64_t deadline_us) {
+    fx_slot_t *slot = (fx_slot_t *)entry;
+    uint8_t level;
+    uint32_t duration_us;
+
+    if (!morse_iter_next(&slot->morse.it, &level, &duration_us)) {
+        fx_set_level(slot->led, 0);
+        ESP_LOGI(TAG, "Dérive Morse : %lld us", (long long)(hal_time_us() - deadline_us));
+        fx_finish(slot);
+        return LED_SCHED_DONE;
+    }
+    fx_set_level(slot->led, level);
+    return deadline_us + duration_us;
+}
+
+// ----------------------------------------------------------------------
+//  Initialisation : minuterie PWM, canaux, fondus matériels, ordonnanceur
+// ----------------------------------------------------------------------
+void led_effects_init(void) {
+    if (s_ready) return;
+
+    hal_pwm_init(FX_FREQ_HZ);
+    s_pm_apb = hal_pm_lock_create(HAL_PM_APB_MAX, "led_apb");
+    s_pm_awake = hal_pm_lock_create(HAL_PM_NO_SLEEP, "led_awake");
+
+    Led *leds[FX_LED_COUNT] = {get_led_ep1(), get_led_ep2(), get_led_err()};
+    for (int i = 0; i < FX_LED_COUNT; i++) {
+        Led *led = leds[i];
+        s_slots[led->channel].led = led;
+        hal_pwm_channel_init(led->channel, led->gpio);
+        led->pwm = 1;
+        fx_detach(led);                           // Mode tout-ou-rien par défaut
+    }
+
+    led_sched_init();
+    s_ready = true;
+    ESP_LOGI(TAG, "Effets LEDC prêts (%d Hz, 10 bits)", FX_FREQ_HZ);
+}
+
+// ----------------------------------------------------------------------
+//  Démarre un effet déclaratif sur une LED (remplace l’effet en cours)
+//  La luminosité de départ est celle de la LED au moment de l’appel.
+//  Un effet en boucle de durée totale nulle n’est joué qu’une fois.
+// ----------------------------------------------------------------------
+void led_effect_start(Led *led, const led_effect_t *effect) {
+    fx_slot_t *slot = fx_slot(led);
+
+    led_sched_lock();
+    fx_cancel(slot);
+    if (!led->pwm) {
+        slot->brightness = led_is_on(led) ? 255 : 0;
+        hal_pwm_set(led->channel, fx_duty(slot->brightness));
+        fx_attach(led);
+    }
+    if (effect != NULL && effect->count > 0) {
+        uint32_t total_ms = 0;
+        for (int i = 0; i < effect->count; i++) {
+            total_ms += effect->frames[i].fade_ms + effect->frames[i].hold_ms;
+        }
+
+        slot->kind = FX_KEYFRAMES;
+        slot->kf.effect = effect;
+        slot->kf.frame = 0;
+        slot->kf.loop = effect->loop && total_ms > 0;
+        fx_update_busy(slot);
+        slot->entry.step = fx_keyframe_step;
+        led_sched_start(&slot->entry, hal_time_us());
+    }
+    led_sched_unlock();
+}
+
+// ----------------------------------------------------------------------
+//  Clignotement tout-ou-rien (count = 0 : jusqu’à l’arrêt)
+// ----------------------------------------------------------------------
+void led_effect_blink(Led *led, uint16_t on_ms, uint16_t off_ms, uint16_t count) {
+    fx_slot_t *slot = fx_slot(led);
+
+    led_sched_lock();
+    fx_cancel(slot);
+    fx_set_level(led, 0);
+    slot->kind = FX_BLINK;
+    fx_update_busy(slot);
+    slot->blink.on_us = (uint32_t)on_ms * 1000;
+    slot->blink.off_us = (uint32_t)off_ms * 1000;
+    slot->blink.remaining = count;
+    slot->entry.step = fx_blink_step;
+    led_sched_start(&slot->entry, hal_time_us());
+    led_sched_unlock();
+}
+
+// ----------------------------------------------------------------------
+//  Message Morse (copié, tronqué à FX_MORSE_MAX caractères)
+//  Les durées sont lues dans timing pendant toute la lecture.
+// ----------------------------------------------------------------------
+void led_effect_morse(Led *led, const morse_timing_t *timing, const char *message) {
+    fx_slot_t *slot = fx_slot(led);
+
+    led_sched_lock();
+    fx_cancel(slot);
+    fx_set_level(led, 0);
+    strncpy(slot->morse.text, message, FX_MORSE_MAX);
+    slot->morse.text[FX_MORSE_MAX] = '\0';
+    morse_iter_init(&slot->morse.it, timing, slot->morse.text);
+    slot->kind = FX_MORSE;
+    fx_update_busy(slot);
+    slot->entry.step = fx_morse_step;
+    led_sched_start(&slot->entry, hal_time_us());
+    led_sched_unlock();
+}
+
+// ----------------------------------------------------------------------
+//  Attend la fin de l’effet en cours sur une LED
+// ----------------------------------------------------------------------
+void led_effect_wait(Led *led) {
+    fx_slot_t *slot = fx_slot(led);
+
+    led_sched_lock();
+    if (slot->kind == FX_NONE) {
+        led_sched_unlock();
+        return;
+    }
+    slot->waiter = xTaskGetCurrentTaskHandle();
+    led_sched_unlock();
+
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+// ----------------------------------------------------------------------
+//  Arrête l’effet et rend la broche au GPIO (état tout-ou-rien conservé)
+//  Un fondu matériel éventuellement en cours se termine sans être visible.
+// ----------------------------------------------------------------------
+void led_effect_stop(Led *led) {
+    if (!s_ready) return;
+    fx_slot_t *slot = fx_slot(led);
+
+    led_sched_lock();
+    fx_cancel(slot);
+    fx_detach(led);
+    led_sched_unlock();
+}
+
+// ----------------------------------------------------------------------
+//  Fixe une luminosité constante (0..255) sans effet
+// ----------------------------------------------------------------------
+void led_set_brightness(Led *led, uint8_t brightness) {
+    fx_slot_t *slot = fx_slot(led);
+
+    led_sched_lock();
+    fx_cancel(slot);
+    slot->brightness = brightness;
+    hal_pwm_set(led->channel, fx_duty(brightness));
+    fx_attach(led);
+    led_sched_unlock();
+}
+
+// ----------------------------------------------------------------------
+//  Masque des LEDs occupées par un effet ou en mode PWM
+// ----------------------------------------------------------------------
+uint32_t led_effects_busy(void) {
+    return s_busy;
+}
+
+// ----------------------------------------------------------------------
+//  Arrête les effets d’un ensemble de LEDs (masque LED_EP1 | ...)
+// ----------------------------------------------------------------------
+void led_effects_release(uint32_t mask) {
+    if (!s_ready) return;
+
+    led_sched_lock();
+    for (int i = 0; i < FX_LED_COUNT; i++) {
+        fx_slot_t *slot = &s_slots[i];
+        if (!(slot->led->mask & mask)) continue;
+        fx_cancel(slot);
+        fx_detach(slot->led);
+    }
+    led_sched_unlock();
+}
@@ -0,0 +1,228 @@
+// ======================================================================
+//  Module : led_sched.c
+//  Description : Ordonnanceur unique de tous les effets lumineux
+//  Fonctionnement :
+//     - Les échéances de tous les effets actifs (Morse, clignotement,
+//       étapes LEDC...) sont rangées dans une roue temporelle de
+//       64 emplacements de 65,5 ms, indexée par l’échéance absolue :
+//       un tour (4,2 s) couvre le point, les espaces entre lettres et
+//       entre mots du Morse à 6 WPM (1,4 s) et les étapes des effets
+//       prédéfinis (1,8 s au plus).
+//     - Un masque de 64 bits indique les emplacements occupés : la
+//       prochaine échéance se trouve par rotation + comptage des zéros
+//       de poids faible ; l’insertion est en O(1), le retrait parcourt
+//       un seul emplacement (une entrée par LED au plus).
+//     - Une seule minuterie (hal_time.h : esp_timer sur l’ESP32) est
+//       armée sur l’échéance exacte (µs) la plus proche : un réveil
+//       par front, quel que soit le nombre de LEDs animées. La largeur
+//       d’un emplacement ne change donc pas la précision.
+//     - Les échéances au-delà d’un tour de roue restent dans leur
+//       emplacement et sont ignorées jusqu’au bon tour ; seul le cas où
+//       toutes le sont demande un parcours complet de la roue.
+// ======================================================================
+
+#include "led_sched.h"
+#include "hal_time.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "led_sched";
+
+// ----------------------------------------------------------------------
+//  Géométrie de la roue
+// ----------------------------------------------------------------------
+#define WHEEL_SLOTS    64                  // Un bit par emplacement
+#define WHEEL_MASK     (WHEEL_SLOTS - 1)
+#define WHEEL_TICK_US  65536               // Largeur d’un emplacement (puissance de 2)
+#define NO_DEADLINE    INT64_MAX
+
+static led_sched_entry_t *s_wheel[WHEEL_SLOTS];
+static uint64_t s_occupied = 0;            // Emplacements non vides
+static uint64_t s_cursor_tick = 0;         // Dernier tick traité
+static int64_t s_armed_us = NO_DEADLINE;   // Échéance de la minuterie
+static hal_timer_t s_timer = NULL;
+static SemaphoreHandle_t s_lock = NULL;
+
+// ----------------------------------------------------------------------
+//  Outils sur le masque d’occupation
+// ----------------------------------------------------------------------
+static inline uint64_t rotr64(uint64_t x, unsigned n) {
+    n &= 63;
+    return n ? (x >> n) | (x << (64 - n)) : x;
+}
+
+static inline uint64_t rotl64(uint64_t x, unsigned n) {
+    n &= 63;
+    return n ? (x << n) | (x >> (64 - n)) : x;
+}
+
+static inline uint64_t tick_of(int64_t t_us) {
+    return (uint64_t)t_us / WHEEL_TICK_US;
+}
+
+// ----------------------------------------------------------------------
+//  Insertion / retrait dans la roue
+//  Une échéance déjà passée est rangée dans l’emplacement courant.
+// ----------------------------------------------------------------------
+static void wheel_insert(led_sched_entry_t *e, int64_t deadline_us) {
+    uint64_t tick = tick_of(deadline_us);
+    if (tick < s_cursor_tick) tick = s_cursor_tick;
+
+    e->deadline_us = deadline_us;
+    e->slot = (uint8_t)(tick & WHEEL_MASK);
+    e->next = s_wheel[e->slot];
+    s_wheel[e->slot] = e;
+    s_occupied |= 1ull << e->slot;
+    e->armed = 1;
+}
+
+static void wheel_remove(led_sched_entry_t *e) {
+    led_sched_entry_t **pp = &s_wheel[e->slot];
+    while (*pp != NULL && *pp != e) pp = &(*pp)->next;
+    if (*pp == e) *pp = e->next;
+    if (s_wheel[e->slot] == NULL) s_occupied &= ~(1ull << e->slot);
+    e->next = NULL;
+    e->armed = 0;
+}
+
+// ----------------------------------------------------------------------
+//  Prochaine échéance : premier emplacement occupé après le curseur
+//  contenant une entrée du tour courant
+// ----------------------------------------------------------------------
+static int64_t wheel_next_deadline(void) {
+    uint64_t rot = rotr64(s_occupied, (unsigned)(s_cursor_tick & WHEEL_MASK));
+
+    while (rot) {
+        unsigned dist = __builtin_ctzll(rot);
+        rot &= rot - 1;
+
+        uint64_t tick = s_cursor_tick + dist;
+        int64_t best = NO_DEADLINE;
+        for (led_sched_entry_t *e = s_wheel[(s_cursor_tick + dist) & WHEEL_MASK]; e; e = e->next) {
+            if (tick_of(e->deadline_us) <= tick && e->deadline_us < best) best = e->deadline_us;
+        }
+        if (best != NO_DEADLINE) return best;
+    }
+
+    // Toutes les échéances sont au-delà d’un tour : minimum global
+    int64_t best = NO_DEADLINE;
+    uint64_t occ = s_occupied;
+    while (occ) {
+        unsigned slot = __builtin_ctzll(occ);
+        occ &= occ - 1;
+        for (led_sched_entry_t *e = s_wheel[slot]; e; e = e->next) {
+            if (e->deadline_us < best) best = e->deadline_us;
+        }
+    }
+    return best;
+}
+
+// ----------------------------------------------------------------------
+//  Exécute les étapes échues entre le curseur et l’instant présent
+//  Chaque étape reçoit son échéance prévue, de sorte que l’échéance
+//  suivante ne dépend pas du retard de réveil.
+// ----------------------------------------------------------------------
+static void wheel_run(int64_t now) {
+    uint64_t now_tick = tick_of(now);
+    uint64_t span = now_tick >= s_cursor_tick ? now_tick - s_cursor_tick + 1 : 1;
+    uint64_t window = span >= WHEEL_SLOTS
+                      ? ~0ull
+                      : rotl64((1ull << span) - 1, (unsigned)(s_cursor_tick & WHEEL_MASK));
+
+    // Détache les entrées échues
+    led_sched_entry_t *due = NULL;
+    uint64_t occ = s_occupied & window;
+    while (occ) {
+        unsigned slot = __builtin_ctzll(occ);
+        occ &= occ - 1;
+
+        led_sched_entry_t **pp = &s_wheel[slot];
+        while (*pp != NULL) {
+            led_sched_entry_t *e = *pp;
+            if (e->deadline_us <= now) {
+                *pp = e->next;
+                e->armed = 0;
+                e->next = due;
+                due = e;
+            } else {
+                pp = &e->next;
+            }
+        }
+        if (s_wheel[slot] == NULL) s_occupied &= ~(1ull << slot);
+    }
+    if (now_tick > s_cursor_tick) s_cursor_tick = now_tick;
+
+    // Exécute puis replanifie
+    while (due != NULL) {
+        led_sched_entry_t *e = due;
+        due = e->next;
+        e->next = NULL;
+
+        int64_t next = e->step(e, e->deadline_us);
+        if (next != LED_SCHED_DONE) wheel_insert(e, next);
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Arme l’unique minuterie sur la prochaine échéance
+// ----------------------------------------------------------------------
+static void sched_rearm(void) {
+    int64_t next = wheel_next_deadline();
+    if (next == s_armed_us) return;
+
+    hal_timer_stop(s_timer);                 // Sans effet si inactive
+    s_armed_us = next;
+    if (next == NO_DEADLINE) return;
+
+    int64_t delay = next - hal_time_us();
+    hal_timer_start_once(s_timer, delay > 0 ? (uint64_t)delay : 0);
+}
+
+static void sched_timer_cb(void *arg) {
+    led_sched_lock();
+    s_armed_us = NO_DEADLINE;
+    wheel_run(hal_time_us());
+    sched_rearm();
+    led_sched_unlock();
+}
+
+// ----------------------------------------------------------------------
+//  Interface publique
+// ----------------------------------------------------------------------
+void led_sched_init(void) {
+    if (s_timer != NULL) return;
+
+    static StaticSemaphore_t lock;
+    s_lock = xSemaphoreCreateMutexStatic(&lock);
+    s_timer = hal_timer_create(sched_timer_cb, NULL, "led_sched");
+    s_cursor_tick = tick_of(hal_time_us());
+    ESP_LOGI(TAG, "Roue de %d x %d us", WHEEL_SLOTS, WHEEL_TICK_US);
+}
+
+void led_sched_lock(void) {
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+}
+
+void led_sched_unlock(void) {
+    xSemaphoreGive(s_lock);
+}
+
+// ----------------------------------------------------------------------
+//  Planifie (ou replanifie) une entrée sur une échéance absolue
+// ----------------------------------------------------------------------
+void led_sched_start(led_sched_entry_t *entry, int64_t deadline_us) {
+    if (entry->armed) wheel_remove(entry);
+    if (s_occupied == 0) s_cursor_tick = tick_of(hal_time_us());
+
+    wheel_insert(entry, deadline_us);
+    if (deadline_us < s_armed_us) sched_rearm();
+}
+
+// ----------------------------------------------------------------------
+//  Retire une entrée ; la minuterie éventuellement armée pour elle
+//  provoquera au pire un réveil sans travail.
+// ----------------------------------------------------------------------
+void led_sched_cancel(led_sched_entry_t *entry) {
+    if (entry->armed) wheel_remove(entry);
+}
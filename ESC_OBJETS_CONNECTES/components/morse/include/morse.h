@@ -0,0 +1,54 @@
+#ifndef MORSE_H
+#define MORSE_H
+#include <stdint.h>
+#include <stdbool.h>
+
+// Vitesse par défaut (mots par minute, référence "PARIS")
+#define MORSE_DEFAULT_WPM 6
+// Vitesse Farnsworth par défaut (0 = espacement standard)
+#define MORSE_DEFAULT_FARNSWORTH_WPM 0
+
+// Durées calculées en microsecondes
+typedef struct {
+    uint32_t dot_us;          // Point (unité de base)
+    uint32_t dash_us;         // Tiret : 3 unités
+    uint32_t symbol_space_us; // Pause entre symboles d'une même lettre
+    uint32_t letter_space_us; // Pause entre lettres
+    uint32_t word_space_us;   // Pause entre mots
+} morse_timing_t;
+
+// Itérateur non bloquant : produit une suite de fronts (niveau, durée)
+typedef struct {
+    const morse_timing_t *timing;
+    const char *text;         // Message restant à jouer
+    const char *pattern;      // Motif de la lettre courante (NULL entre lettres)
+    uint8_t pending_off;      // 1 si le prochain front est une extinction
+} morse_iter_t;
+
+// Symboles par lettre au plus (chiffres)
+#define MORSE_MAX_SYMBOLS 5
+
+// Décodeur Morse : mémoire constante, temps borné par front
+typedef struct {
+    uint32_t dot_us;          // Estimation d’un point
+    uint32_t dash_us;         // Estimation d’un tiret
+    uint32_t gap_us;          // Estimation du silence entre symboles
+    uint32_t letter_gap_us;   // Estimation du silence entre lettres (0 = inconnue)
+    int64_t last_edge_us;     // Horodatage du dernier front retenu
+    uint32_t marks[MORSE_MAX_SYMBOLS]; // Marques de la lettre en cours
+    uint8_t count;            // Marques reçues (> MORSE_MAX_SYMBOLS : lettre invalide)
+    uint8_t pressed;          // Niveau courant (1 = appuyé)
+    uint8_t pending_space;    // 1 si une lettre a été émise depuis le dernier espace
+} morse_decoder_t;
+
+void morse_timing_init(morse_timing_t *timing, unsigned wpm, unsigned farnsworth_wpm);
+const char *morse_pattern(char c);
+void morse_iter_init(morse_iter_t *it, const morse_timing_t *timing, const char *text);
+bool morse_iter_next(morse_iter_t *it, uint8_t *level, uint32_t *duration_us);
+
+void morse_decoder_init(morse_decoder_t *dec, uint32_t dot_us);
+int morse_decoder_edge(morse_decoder_t *dec, bool pressed, int64_t t_us, char out[2]);
+int morse_decoder_poll(morse_decoder_t *dec, int64_t now_us, char out[2]);
+int64_t morse_decoder_deadline(const morse_decoder_t *dec);
+
+#endif
@@ -0,0 +1,321 @@
+// ======================================================================
+//  Module : morse.c
+//  Description : Table du code Morse et calcul des durées de signalisation
+//  Fonctionnement :
+//     - Convertit une vitesse en mots par minute (WPM, mot "PARIS")
+//       en durées absolues, avec espacement Farnsworth optionnel.
+//     - Fournit un itérateur qui découpe un message en fronts
+//       (niveau + durée) sans jamais bloquer : c’est à l’appelant
+//       de planifier chaque front sur une échéance absolue.
+//     - Décode les appuis d’un joueur (fronts horodatés) en caractères,
+//       en suivant sa vitesse (point, tiret, silences estimés à part).
+//     - Aucune dépendance matérielle : le module compile aussi sur hôte.
+// ======================================================================
+
+#include "morse.h"
+#include <ctype.h>                 // Pour toupper()
+#include <stddef.h>
+#include <stdint.h>
+
+// ----------------------------------------------------------------------
+//  Table du code Morse (lettre → motif . et -)
+// ----------------------------------------------------------------------
+typedef struct {
+    char letter;
+    const char *pattern;
+} morse_t;
+
+static const morse_t morse_table[] = {
+    {'A', ".-"}, {'B', "-..."}, {'C', "-.-."}, {'D', "-.."}, {'E', "."},
+    {'F', "..-."}, {'G', "--."}, {'H', "...."}, {'I', ".."}, {'J', ".---"},
+    {'K', "-.-"}, {'L', ".-.."}, {'M', "--"}, {'N', "-."}, {'O', "---"},
+    {'P', ".--."}, {'Q', "--.-"}, {'R', ".-."}, {'S', "..."}, {'T', "-"},
+    {'U', "..-"}, {'V', "...-"}, {'W', ".--"}, {'X', "-..-"}, {'Y', "-.--"},
+    {'Z', "--.."},
+    {'1', ".----"}, {'2', "..---"}, {'3', "...--"}, {'4', "....-"}, {'5', "....."},
+    {'6', "-...."}, {'7', "--..."}, {'8', "---.."}, {'9', "----."}, {'0', "-----"}
+};
+
+// ----------------------------------------------------------------------
+//  Table de décodage : arbre binaire à plat
+//  Départ à l’index 1 ; un point donne 2i, un tiret 2i + 1.
+//  Cinq symboles au plus, donc 64 entrées ('\0' = code inconnu).
+// ----------------------------------------------------------------------
+#define MORSE_TREE_SIZE 64
+
+static const char morse_tree[MORSE_TREE_SIZE] = {
+    '\0', '\0', 'E', 'T', 'I', 'A', 'N', 'M', 'S', 'U', 'R', 'W', 'D', 'K', 'G', 'O',
+    'H', 'V', 'F', '\0', 'L', '\0', 'P', 'J', 'B', 'X', 'C', 'Y', 'Z', 'Q', '\0', '\0',
+    '5', '4', '\0', '3', '\0', '\0', '\0', '2', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '1',
+    '6', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '7', '\0', '\0', '\0', '8', '\0', '9', '0',
+};
+
+// ----------------------------------------------------------------------
+//  Paramètres du décodeur
+// ----------------------------------------------------------------------
+#define DECODER_DEBOUNCE_US  10000     // Rebonds mécaniques ignorés
+#define DECODER_DOT_MIN_US   20000     // ~60 WPM
+#define DECODER_DOT_MAX_US   1000000   // ~1 WPM
+#define DECODER_GAP_MAX_US   5000000   // Silence entre lettres le plus long suivi
+
+// ----------------------------------------------------------------------
+//  Calcul des durées à partir de la vitesse
+//  - wpm            : vitesse des caractères (1 point = 1,2 s / wpm)
+//  - farnsworth_wpm : vitesse globale ; si elle est plus basse que wpm,
+//                     les caractères gardent leur vitesse mais les pauses
+//                     entre lettres et mots sont allongées (méthode ARRL)
+// ----------------------------------------------------------------------
+void morse_timing_init(morse_timing_t *timing, unsigned wpm, unsigned farnsworth_wpm) {
+    if (wpm == 0) wpm = MORSE_DEFAULT_WPM;
+
+    uint32_t dot = 1200000u / wpm;
+    timing->dot_us = dot;
+    timing->dash_us = 3 * dot;
+    timing->symbol_space_us = dot;
+
+    if (farnsworth_wpm == 0 || farnsworth_wpm >= wpm) {
+        timing->letter_space_us = 3 * dot;
+        timing->word_space_us = 7 * dot;
+        return;
+    }
+
+    // Délai total à répartir sur les 19 unités d’espacement du mot "PARIS"
+    uint64_t ta = (60000000ull * wpm - 37200000ull * farnsworth_wpm)
+                  / ((uint64_t)farnsworth_wpm * wpm);
+    timing->letter_space_us = (uint32_t)(3 * ta / 19);
+    timing->word_space_us = (uint32_t)(7 * ta / 19);
+}
+
+// ----------------------------------------------------------------------
+//  Recherche du motif d’un caractère (NULL si inconnu)
+// ----------------------------------------------------------------------
+const char *morse_pattern(char c) {
+    c = toupper((unsigned char)c);
+    for (size_t i = 0; i < sizeof(morse_table) / sizeof(morse_t); i++) {
+        if (morse_table[i].letter == c) return morse_table[i].pattern;
+    }
+    return NULL;
+}
+
+// ----------------------------------------------------------------------
+//  Prépare l’itérateur sur un message
+// ----------------------------------------------------------------------
+void morse_iter_init(morse_iter_t *it, const morse_timing_t *timing, const char *text) {
+    it->timing = timing;
+    it->text = text;
+    it->pattern = NULL;
+    it->pending_off = 0;
+}
+
+// ----------------------------------------------------------------------
+//  Produit le front suivant du message
+//  Retourne false lorsque le message est terminé.
+//  Chaque symbole donne deux fronts : allumage (point/tiret) puis
+//  extinction (pause symbole, lettre ou mot selon ce qui suit).
+// ----------------------------------------------------------------------
+bool morse_iter_next(morse_iter_t *it, uint8_t *level, uint32_t *duration_us) {
+    const morse_timing_t *t = it->timing;
+
+    if (it->pending_off) {
+        it->pending_off = 0;
+        *level = 0;
+
+        if (*it->pattern != '\0') {
+            *duration_us = t->symbol_space_us;     // Symbole suivant de la lettre
+            return true;
+        }
+
+        it->pattern = NULL;                        // Fin de la lettre
+        if (*it->text == ' ') {
+            while (*it->text == ' ') it->text++;   // Plusieurs espaces = un mot
+            *duration_us = t->word_space_us;
+        } else {
+            *duration_us = t->letter_space_us;
+        }
+        return true;
+    }
+
+    while (it->pattern == NULL) {
+        char c = *it->text;
+        if (c == '\0') return false;
+        it->text++;
+
+        // Espace en tête de message
+        if (c == ' ') {
+            *level = 0;
+            *duration_us = t->word_space_us;
+            return true;
+        }
+        it->pattern = morse_pattern(c);            // Caractère inconnu ignoré
+    }
+
+    *level = 1;
+    *duration_us = (*it->pattern++ == '.') ? t->dot_us : t->dash_us;
+    it->pending_off = 1;
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Décodeur : trois estimations suivent le joueur
+//  - marques : point et tiret estimés séparément ; une marque est un
+//    tiret au-delà du milieu des deux. Une lettre qui contient les deux
+//    (plus longue ≥ 2 × plus courte) se classe sur le milieu de ses
+//    propres marques, ce qui recale les estimations dès la première
+//    lettre à une autre vitesse.
+//  - silence entre symboles : fin de lettre au-delà du double.
+//  - silence entre lettres : fin de mot au-delà de 5/3 (mot = 7/3 de
+//    lettre, Farnsworth compris). Inconnu au départ, il prend la valeur
+//    du premier silence entre lettres, sans espace.
+//  Un échantillon à plus d’un facteur 3/2 de l’estimation la remplace ;
+//  sinon moyenne glissante.
+// ----------------------------------------------------------------------
+static bool decoder_track(uint32_t *estimate, uint32_t sample) {
+    if (3 * (uint64_t)sample < 2 * (uint64_t)*estimate || 2 * (uint64_t)sample > 3 * (uint64_t)*estimate) {
+        *estimate = sample;                              // Changement de vitesse
+        return true;
+    }
+    *estimate = (*estimate + sample) / 2;                // Moyenne glissante
+    return false;
+}
+
+static uint32_t decoder_clamp(int64_t d, uint32_t lo, uint32_t hi) {
+    return d < lo ? lo : d > hi ? hi : (uint32_t)d;
+}
+
+// Seuil de fin de mot (-1 : silence entre lettres encore inconnu)
+static int64_t decoder_word_gap(const morse_decoder_t *dec) {
+    return dec->letter_gap_us ? 5 * (int64_t)dec->letter_gap_us / 3 : -1;
+}
+
+// Classe les marques de la lettre en cours et l’émet (si elle existe)
+static int decoder_flush(morse_decoder_t *dec, char *out) {
+    uint8_t count = dec->count;
+    if (count == 0) return 0;
+
+    dec->count = 0;
+    dec->pending_space = 1;
+    if (count > MORSE_MAX_SYMBOLS) {
+        *out = '?';
+        return 1;
+    }
+
+    uint32_t lo = UINT32_MAX, hi = 0;
+    for (int i = 0; i < count; i++) {
+        if (dec->marks[i] < lo) lo = dec->marks[i];
+        if (dec->marks[i] > hi) hi = dec->marks[i];
+    }
+    uint32_t split = hi >= 2 * lo ? (lo + hi) / 2 : (dec->dot_us + dec->dash_us) / 2;
+
+    uint8_t code = 1;
+    uint32_t sum[2] = {0, 0};
+    uint8_t n[2] = {0, 0};
+    for (int i = 0; i < count; i++) {
+        uint8_t dash = dec->marks[i] >= split;
+        code = code * 2 + dash;
+        sum[dash] += dec->marks[i];
+        n[dash]++;
+    }
+
+    bool dot_moved = n[0] && decoder_track(&dec->dot_us, sum[0] / n[0]);
+    bool dash_moved = n[1] && decoder_track(&dec->dash_us, sum[1] / n[1]);
+    if (dot_moved && !n[1]) dec->dash_us = 3 * dec->dot_us;
+    if (dash_moved && !n[0]) dec->dot_us = dec->dash_us / 3;
+    dec->dot_us = decoder_clamp(dec->dot_us, DECODER_DOT_MIN_US, DECODER_DOT_MAX_US);
+    if (dec->dash_us < 2 * dec->dot_us) dec->dash_us = 3 * dec->dot_us;
+
+    char c = morse_tree[code];
+    *out = c ? c : '?';
+    return 1;
+}
+
+// Silence qui suit une lettre émise : entre lettres ou entre mots
+static int decoder_space(morse_decoder_t *dec, int64_t gap, char *out) {
+    if (!dec->pending_space) return 0;
+
+    int64_t word = decoder_word_gap(dec);
+    if (word >= 0 && gap >= word) {
+        dec->pending_space = 0;
+        *out = ' ';
+        return 1;
+    }
+    uint32_t sample = decoder_clamp(gap, DECODER_DOT_MIN_US, DECODER_GAP_MAX_US);
+    if (dec->letter_gap_us == 0) dec->letter_gap_us = sample;
+    else decoder_track(&dec->letter_gap_us, sample);
+    return 0;
+}
+
+void morse_decoder_init(morse_decoder_t *dec, uint32_t dot_us) {
+    dec->dot_us = dot_us ? dot_us : 1200000u / MORSE_DEFAULT_WPM;
+    dec->dash_us = 3 * dec->dot_us;
+    dec->gap_us = dec->dot_us;
+    dec->letter_gap_us = 0;
+    dec->last_edge_us = 0;
+    dec->count = 0;
+    dec->pressed = 0;
+    dec->pending_space = 0;
+}
+
+// ----------------------------------------------------------------------
+//  Traite un front (appelable depuis une ISR, temps borné)
+//  Retourne le nombre de caractères écrits dans out (0 à 2).
+// ----------------------------------------------------------------------
+int morse_decoder_edge(morse_decoder_t *dec, bool pressed, int64_t t_us, char out[2]) {
+    int n = 0;
+    if (pressed == dec->pressed) return 0;                  // Front en double
+
+    int64_t d = t_us - dec->last_edge_us;
+    if (dec->last_edge_us != 0 && d < DECODER_DEBOUNCE_US) return 0;
+
+    if (pressed) {
+        // Fin d’un silence
+        if (dec->last_edge_us == 0) {
+            // Premier appui : rien avant
+        } else if (d >= 2 * (int64_t)dec->gap_us) {
+            n += decoder_flush(dec, &out[n]);
+            n += decoder_space(dec, d, &out[n]);
+        } else if (dec->count != 0) {
+            decoder_track(&dec->gap_us, decoder_clamp(d, DECODER_DOT_MIN_US, DECODER_DOT_MAX_US));
+        }
+    } else {
+        // Fin d’une marque, classée avec le reste de la lettre
+        if (dec->count < MORSE_MAX_SYMBOLS) {
+            dec->marks[dec->count] = decoder_clamp(d, 0, DECODER_DOT_MAX_US * 3);
+        }
+        if (dec->count <= MORSE_MAX_SYMBOLS) dec->count++;
+    }
+
+    dec->pressed = pressed;
+    dec->last_edge_us = t_us;
+    return n;
+}
+
+// ----------------------------------------------------------------------
+//  Fin de lettre / de mot sans nouvel appui (à l’échéance donnée par
+//  morse_decoder_deadline)
+// ----------------------------------------------------------------------
+int morse_decoder_poll(morse_decoder_t *dec, int64_t now_us, char out[2]) {
+    int n = 0;
+    if (dec->pressed) return 0;
+
+    int64_t gap = now_us - dec->last_edge_us;
+    if (gap >= 2 * (int64_t)dec->gap_us) n += decoder_flush(dec, &out[n]);
+
+    int64_t word = decoder_word_gap(dec);
+    if (word >= 0 && gap >= word && dec->pending_space) {
+        out[n++] = ' ';
+        dec->pending_space = 0;
+    }
+    return n;
+}
+
+// ----------------------------------------------------------------------
+//  Prochaine échéance à surveiller (-1 : aucune)
+// ----------------------------------------------------------------------
+int64_t morse_decoder_deadline(const morse_decoder_t *dec) {
+    if (dec->pressed) return -1;
+    if (dec->count != 0) return dec->last_edge_us + 2 * (int64_t)dec->gap_us;
+
+    int64_t word = decoder_word_gap(dec);
+    if (dec->pending_space && word >= 0) return dec->last_edge_us + word;
+    return -1;
+}
@@ -1,8 +1,19 @@
 #ifndef PUSH_BUTTON_H
 #define PUSH_BUTTON_H
-#include "driver/gpio.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Rappel d’appui (1) / relâchement (0), appelé depuis l’ISR du bouton.
+// Retourne true si une tâche plus prioritaire a été réveillée.
+typedef bool (*button_isr_cb_t)(int pressed);
+
+// Caractère Morse décodé (' ' entre deux mots), appelé depuis la
+// minuterie du décodeur
+typedef void (*button_morse_cb_t)(char c);
 
 void button_init();
 int button_poll(void);
+void button_start(button_isr_cb_t cb);
+void button_morse_start(button_morse_cb_t cb);
 
 #endif
\ No newline at end of file
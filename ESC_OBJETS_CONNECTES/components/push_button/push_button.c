@@ -1,26 +1,57 @@
 // ======================================================================
 //  Commentaires écrits par l'intelligence artificielle
 // Module : push_button.c
-//  Description : Gestion d’un bouton-poussoir sur ESP32
+//  Description : Gestion d’un bouton-poussoir sur ESP32 (ou carte simulée)
 //  Fonctionnement :
 //    - Configure un GPIO comme entrée pour détecter un appui.
 //    - Fournit une fonction d’interrogation simple (polling) du niveau logique.
 //    - Retourne 1 si le bouton est appuyé, 0 sinon.
+//    - Optionnellement, décode le Morse tapé par le joueur : chaque front
+//      est horodaté dans une ISR (temps borné, mémoire constante), la
+//      lettre est classée à sa fin ; chaque caractère décodé est remis
+//      au rappel depuis la minuterie du décodeur, seul appelant.
 // ======================================================================
 
 #include "push_button.h"
-#include "driver/gpio.h"
+#include "hal_gpio.h"
+#include "hal_time.h"
 #include "esp_log.h"
+#include "morse.h"
+#include "freertos/FreeRTOS.h"
 
 // Tag pour l’affichage des messages de log dans la console série
 static const char *TAG = "push_button.c";
 
 // Variable interne stockant le numéro de broche utilisée
-static gpio_num_t s_button_gpio = -1;
+static hal_pin_t s_button_gpio = -1;
 
 // Broche utilisée par le bouton (GPIO 23 = entrée classique avec pull-down interne)
 #define PUSH_BUTTON_GPIO 23
 
+// Caractères décodés dans l’ISR, en attente de la minuterie
+#define MORSE_PENDING_MAX 4
+
+// Rebonds ignorés pour les événements d’appui / relâchement
+#define BUTTON_DEBOUNCE_US 20000
+
+// ----------------------------------------------------------------------
+//  Mode événementiel : ISR unique sur les deux fronts du bouton
+// ----------------------------------------------------------------------
+static button_isr_cb_t s_button_cb = NULL;
+static int64_t s_last_edge_us = 0;
+static int s_last_level = 0;
+static bool s_isr_installed = false;
+
+// ----------------------------------------------------------------------
+//  État du décodeur Morse (partagé entre l’ISR et la minuterie)
+// ----------------------------------------------------------------------
+static morse_decoder_t s_decoder;
+static button_morse_cb_t s_morse_cb = NULL;
+static hal_timer_t s_morse_timer = NULL;
+static char s_morse_pending[MORSE_PENDING_MAX];
+static uint8_t s_morse_pending_len = 0;
+static portMUX_TYPE s_morse_mux = portMUX_INITIALIZER_UNLOCKED;
+
 // ----------------------------------------------------------------------
 //  Initialisation du bouton
 //  - Définit la broche comme entrée
@@ -32,22 +63,129 @@ void button_init()
     ESP_LOGI(TAG, "Configuration du GPIO %d en entrée", PUSH_BUTTON_GPIO);
 
     s_button_gpio = PUSH_BUTTON_GPIO;          // Mémorise le GPIO utilisé
-    gpio_reset_pin(s_button_gpio);             // Réinitialise la broche
-    gpio_set_direction(s_button_gpio, GPIO_MODE_INPUT);  // Définit en entrée
 
-    // Active une résistance interne de pull-down (maintient à 0 lorsqu’inactif)
-    gpio_set_pull_mode(s_button_gpio, GPIO_PULLDOWN_ONLY);
+    // Entrée avec résistance interne de pull-down (maintient à 0 lorsqu’inactif)
+    hal_gpio_input(s_button_gpio, HAL_PULL_DOWN);
 }
 
 // ----------------------------------------------------------------------
 //  Lecture de l’état du bouton
 //  - Renvoie 1 si le bouton est pressé, 0 sinon.
 //  - Utilise une lecture directe (polling) sans interruption.
-//  - Log le résultat pour le débogage (console série).
+//  - Log le résultat au niveau débogage (console série).
 // ----------------------------------------------------------------------
 int button_poll(void)
 {
-    int level = gpio_get_level(s_button_gpio);  // Lecture du niveau logique
-    ESP_LOGI(TAG, "Bouton %s", level ? "appuyé" : "relâché");
+    int level = hal_gpio_get(s_button_gpio);  // Lecture du niveau logique
+    ESP_LOGD(TAG, "Bouton %s", level ? "appuyé" : "relâché");
     return level;
 }
+
+// ----------------------------------------------------------------------
+//  Arme la minuterie de fin de lettre / de mot (verrou pris)
+//  Caractères en attente : tout de suite, pour les remettre au rappel
+// ----------------------------------------------------------------------
+static void morse_arm_timeout(int64_t now) {
+    int64_t deadline = s_morse_pending_len ? now : morse_decoder_deadline(&s_decoder);
+    hal_timer_stop(s_morse_timer);
+    if (deadline >= 0) {
+        hal_timer_start_once(s_morse_timer, deadline > now ? (uint64_t)(deadline - now) : 0);
+    }
+}
+
+// ----------------------------------------------------------------------
+//  ISR sur chaque front du bouton
+//  - Événement appui / relâchement (anti-rebond) vers le rappel
+//  - Horodatage pour le décodeur Morse ; une lettre terminée par cet
+//    appui attend la minuterie, qui la remet au rappel
+// ----------------------------------------------------------------------
+static void button_edge_isr(void *arg) {
+    int64_t now = hal_time_us();
+    int level = hal_gpio_get(s_button_gpio) != 0;
+    BaseType_t woken = pdFALSE;
+
+    if (s_button_cb != NULL && level != s_last_level && now - s_last_edge_us >= BUTTON_DEBOUNCE_US) {
+        s_last_level = level;
+        s_last_edge_us = now;
+        if (s_button_cb(level)) woken = pdTRUE;
+    }
+
+    if (s_morse_cb != NULL) {
+        char out[2];
+        portENTER_CRITICAL_ISR(&s_morse_mux);
+        int n = morse_decoder_edge(&s_decoder, level, now, out);
+        for (int i = 0; i < n && s_morse_pending_len < MORSE_PENDING_MAX; i++) {
+            s_morse_pending[s_morse_pending_len++] = out[i];
+        }
+        morse_arm_timeout(now);
+        portEXIT_CRITICAL_ISR(&s_morse_mux);
+    }
+
+    if (woken) portYIELD_FROM_ISR();
+}
+
+// ----------------------------------------------------------------------
+//  Installe l’ISR du bouton (une seule fois pour les deux usages)
+// ----------------------------------------------------------------------
+static void button_isr_install(void) {
+    if (s_isr_installed) return;
+
+    hal_gpio_isr_add(s_button_gpio, HAL_EDGE_ANY, button_edge_isr, NULL);
+    s_isr_installed = true;
+}
+
+// ----------------------------------------------------------------------
+//  Mode événementiel : cb est appelée depuis l’ISR à chaque appui (1)
+//  et relâchement (0). Elle retourne true si une tâche plus prioritaire
+//  a été réveillée.
+// ----------------------------------------------------------------------
+void button_start(button_isr_cb_t cb)
+{
+    s_last_level = hal_gpio_get(s_button_gpio);
+    s_button_cb = cb;
+    button_isr_install();
+}
+
+// ----------------------------------------------------------------------
+//  Minuterie : caractères laissés par l’ISR, puis silence assez long
+//  pour terminer une lettre ou un mot
+// ----------------------------------------------------------------------
+static void morse_timeout_cb(void *arg) {
+    int64_t now = hal_time_us();
+    char out[MORSE_PENDING_MAX + 2];
+    int n = 0;
+
+    portENTER_CRITICAL(&s_morse_mux);
+    while (n < s_morse_pending_len) {
+        out[n] = s_morse_pending[n];
+        n++;
+    }
+    s_morse_pending_len = 0;
+    n += morse_decoder_poll(&s_decoder, now, &out[n]);
+    morse_arm_timeout(now);
+    portEXIT_CRITICAL(&s_morse_mux);
+
+    for (int i = 0; i < n; i++) s_morse_cb(out[i]);
+}
+
+// ----------------------------------------------------------------------
+//  Active le décodage Morse sur le bouton
+//  - Le bouton doit avoir été initialisé (button_init)
+//  - La vitesse initiale est celle des LEDs ; elle suit ensuite le joueur
+//  - cb reçoit chaque caractère décodé (' ' entre deux mots), toujours
+//    depuis la tâche de la minuterie : un seul producteur
+// ----------------------------------------------------------------------
+void button_morse_start(button_morse_cb_t cb)
+{
+    if (s_morse_cb != NULL) return;
+
+    morse_decoder_init(&s_decoder, 0);
+    s_morse_timer = hal_timer_create(morse_timeout_cb, NULL, "morse_rx");
+
+    // Rappel publié en dernier : l’ISR (déjà installée par button_start)
+    // ne décode qu’à partir de là, minuterie prête
+    s_morse_cb = cb;
+
+    button_isr_install();
+    ESP_LOGI(TAG, "Décodage Morse actif sur GPIO %d", s_button_gpio);
+}
@@ -0,0 +1,10 @@
+#ifndef SIM_H
+#define SIM_H
+
+// ----------------------------------------------------------------------
+//  Carte simulée (cible linux) : à appeler avant l’initialisation des
+//  pilotes. Réglages par variables d’environnement, voir sim.c.
+// ----------------------------------------------------------------------
+void sim_start(void);
+
+#endif
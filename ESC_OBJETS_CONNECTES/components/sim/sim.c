@@ -0,0 +1,128 @@
+// ======================================================================
+//  Module : sim.c
+//  Description : Démarrage de la carte simulée (cible linux)
+//  Fonctionnement :
+//     - Branche clavier, bouton, LEDs et écran sur la HAL hôte.
+//     - Copie les images demandées dans la flash émulée avant que le
+//       jeu ne lise ses partitions :
+//         SIM_ASSETS   paquet de ressources (défaut : build/assets.bin)
+//         SIM_JOURNAL  journal enregistré sur une vraie boîte (rejeu)
+//     - SIM_SCRIPT=<fichier> : joue le scénario puis quitte avec le
+//       code 0 (succès) ou 1. L’horloge est pilotée : les attentes ne
+//       coûtent rien, sauf avec SIM_REALTIME=1.
+//       SIM_JOURNAL_OUT=<fichier> recopie ensuite la partition "journal".
+//     - Sans script : console interactive (sim_tui.c).
+// ======================================================================
+
+#include "sim.h"
+#include "sim_board.h"
+#include "hal_host.h"
+#include "esp_partition.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *TAG = "sim";
+
+#define SIM_ASSETS_DEFAULT   "build/assets.bin"
+#define JOURNAL_SETTLE_MS    6000    // Le journal est vidé en flash toutes les 5 s
+
+// ----------------------------------------------------------------------
+//  Flash émulée
+// ----------------------------------------------------------------------
+static const esp_partition_t *partition(const char *name) {
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           ESP_PARTITION_SUBTYPE_ANY, name);
+    if (part == NULL) ESP_LOGE(TAG, "Partition \"%s\" absente", name);
+    return part;
+}
+
+static void flash_load(const char *name, const char *path) {
+    const esp_partition_t *part = partition(name);
+    FILE *f = fopen(path, "rb");
+    if (part == NULL || f == NULL) {
+        ESP_LOGW(TAG, "%s non chargé dans \"%s\"", path, name);
+        if (f) fclose(f);
+        return;
+    }
+
+    uint8_t *buf = malloc(part->size);
+    size_t n = fread(buf, 1, part->size, f);
+    fclose(f);
+    ESP_ERROR_CHECK(esp_partition_erase_range(part, 0, part->size));
+    ESP_ERROR_CHECK(esp_partition_write(part, 0, buf, n));
+    free(buf);
+    ESP_LOGI(TAG, "%s -> \"%s\" (%u octets)", path, name, (unsigned)n);
+}
+
+static void flash_save(const char *name, const char *path) {
+    const esp_partition_t *part = partition(name);
+    FILE *f = fopen(path, "wb");
+    if (part == NULL || f == NULL) {
+        ESP_LOGE(TAG, "\"%s\" non recopié dans %s", name, path);
+        if (f) fclose(f);
+        return;
+    }
+
+    uint8_t *buf = malloc(part->size);
+    ESP_ERROR_CHECK(esp_partition_read(part, 0, buf, part->size));
+    fwrite(buf, 1, part->size, f);
+    fclose(f);
+    free(buf);
+}
+
+// ----------------------------------------------------------------------
+//  Tâches
+// ----------------------------------------------------------------------
+static int64_t real_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void script_task(void *arg) {
+    const char *path = arg;
+    int64_t real0 = real_us(), sim0 = hal_time_us();
+
+    bool ok = sim_script_run(path);
+
+    const char *out = getenv("SIM_JOURNAL_OUT");
+    if (out) {
+        hal_delay_ms(JOURNAL_SETTLE_MS);
+        flash_save("journal", out);
+    }
+
+    double sim_s = (hal_time_us() - sim0) / 1e6;
+    double real_s = (real_us() - real0) / 1e6;
+    printf("%s : %s — %.1f s simulées en %.2f s (x%.0f)\n", path, ok ? "OK" : "ÉCHEC",
+           sim_s, real_s, real_s > 0 ? sim_s / real_s : 0);
+    fflush(stdout);
+    exit(ok ? 0 : 1);
+}
+
+static void tui_task(void *arg) {
+    sim_tui_run();
+}
+
+void sim_start(void) {
+    sim_board_init();
+
+    const char *assets = getenv("SIM_ASSETS");
+    flash_load("assets", assets ? assets : SIM_ASSETS_DEFAULT);
+    const char *journal = getenv("SIM_JOURNAL");
+    if (journal) flash_load("journal", journal);
+
+    const char *script = getenv("SIM_SCRIPT");
+    if (script == NULL) {
+        xTaskCreate(tui_task, "sim_tui", 4096, NULL, 5, NULL);
+        return;
+    }
+
+    const char *realtime = getenv("SIM_REALTIME");
+    hal_host_clock_manual(realtime == NULL || strcmp(realtime, "1") != 0);
+    xTaskCreate(script_task, "sim_script", 8192, (void *)script, 5, NULL);
+}
@@ -0,0 +1,211 @@
+// ======================================================================
+//  Module : sim_board.c
+//  Description : Périphériques de la boîte sur la carte simulée
+//  Fonctionnement :
+//     - Clavier 4x4 : une touche appuyée relie sa ligne à sa colonne ;
+//       la colonne suit donc la ligne tant que celle-ci est à 0, sinon
+//       elle revient au niveau de sa résistance de tirage.
+//     - Bouton : broche imposée à 1 pendant l’appui (pull-down sinon).
+//     - LEDs : niveau de la sortie, ou rapport cyclique du canal PWM
+//       quand un effet LEDC tient la broche.
+//     - Écran : PCF8574 + HD44780 en mode 4 bits ; chaque front
+//       descendant de EN transmet un quartet, RS choisit commande ou
+//       donnée. DDRAM et CGRAM sont tenues comme dans le contrôleur.
+// ======================================================================
+
+#include "sim_board.h"
+#include "hal_host.h"
+#include "hal_pwm.h"
+#include <string.h>
+#include <strings.h>
+
+// ----------------------------------------------------------------------
+//  Câblage (tableau "Matériel utilisé" du README)
+// ----------------------------------------------------------------------
+static const hal_pin_t s_row_pins[4] = {13, 19, 14, 27};
+static const hal_pin_t s_col_pins[4] = {26, 25, 33, 32};
+static const char s_layout[4][4] = {
+    {'5', '6', 'B', '7'},
+    {'8', '9', 'C', '*'},
+    {'0', '#', 'D', '1'},
+    {'2', '3', 'A', '4'}
+};
+#define BUTTON_PIN 23
+static const hal_pin_t s_led_pins[SIM_LED_COUNT] = {5, 4, 2};
+static const char *const s_led_names[SIM_LED_COUNT] = {"ep1", "ep2", "err"};
+#define LCD_ADDR 0x27
+
+// ----- Bits du PCF8574 -----
+#define PCF_RS 0x01
+#define PCF_EN 0x04
+
+static bool s_pressed[4][4];
+static uint8_t s_led[SIM_LED_COUNT];
+static volatile uint32_t s_version = 0;
+
+static struct {
+    uint8_t ddram[0x80];
+    uint8_t cgram[64];
+    uint8_t addr;
+    bool cgram_mode;       // Écritures vers la CGRAM (caractères personnalisés)
+    uint8_t bus;           // Dernier octet reçu par le PCF8574
+    uint8_t high;          // Quartet de poids fort en attente
+    bool half;             // true : poids fort reçu
+} s_lcd;
+
+// ----------------------------------------------------------------------
+//  Clavier
+// ----------------------------------------------------------------------
+static void keypad_update(void) {
+    for (int c = 0; c < 4; c++) {
+        int level = -1;                            // Relâchée : tirage interne
+        for (int r = 0; r < 4; r++) {
+            if (s_pressed[r][c] && hal_host_output(s_row_pins[r]) == 0) level = 0;
+        }
+        hal_host_drive(s_col_pins[c], level);
+    }
+}
+
+bool sim_key(char key, bool pressed) {
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            if (s_layout[r][c] != key) continue;
+            s_pressed[r][c] = pressed;
+            keypad_update();
+            return true;
+        }
+    }
+    return false;
+}
+
+void sim_button(bool pressed) {
+    hal_host_drive(BUTTON_PIN, pressed ? 1 : -1);
+}
+
+// ----------------------------------------------------------------------
+//  LEDs
+// ----------------------------------------------------------------------
+static int led_of(hal_pin_t pin) {
+    for (int i = 0; i < SIM_LED_COUNT; i++) {
+        if (s_led_pins[i] == pin) return i;
+    }
+    return -1;
+}
+
+static void led_set(hal_pin_t pin, uint8_t brightness) {
+    int led = led_of(pin);
+    if (led < 0 || s_led[led] == brightness) return;
+    s_led[led] = brightness;
+    s_version++;
+}
+
+uint8_t sim_led(sim_led_t led) {
+    return s_led[led];
+}
+
+const char *sim_led_name(sim_led_t led) {
+    return s_led_names[led];
+}
+
+int sim_led_find(const char *name) {
+    for (int i = 0; i < SIM_LED_COUNT; i++) {
+        if (strcasecmp(name, s_led_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// ----------------------------------------------------------------------
+//  Écran HD44780
+// ----------------------------------------------------------------------
+static void lcd_command(uint8_t v) {
+    if (v & 0x80) {                                // Set DDRAM Address
+        s_lcd.addr = v & 0x7F;
+        s_lcd.cgram_mode = false;
+    } else if (v & 0x40) {                         // Set CGRAM Address
+        s_lcd.addr = v & 0x3F;
+        s_lcd.cgram_mode = true;
+    } else if (v == 0x01) {                        // Clear display
+        memset(s_lcd.ddram, ' ', sizeof(s_lcd.ddram));
+        s_lcd.addr = 0;
+        s_lcd.cgram_mode = false;
+    } else if ((v & 0xFE) == 0x02) {               // Return home
+        s_lcd.addr = 0;
+    }
+    // Mode d’entrée, affichage, fonction : sans effet sur le contenu
+}
+
+static void lcd_data(uint8_t v) {
+    if (s_lcd.cgram_mode) {
+        s_lcd.cgram[s_lcd.addr & 0x3F] = v;
+        s_lcd.addr = (s_lcd.addr + 1) & 0x3F;
+    } else {
+        s_lcd.ddram[s_lcd.addr & 0x7F] = v;
+        s_lcd.addr = (s_lcd.addr + 1) & 0x7F;
+    }
+}
+
+// Octet écrit sur le PCF8574 : un quartet par front descendant de EN
+static void lcd_bus(uint8_t b) {
+    bool latch = (s_lcd.bus & PCF_EN) && !(b & PCF_EN);
+    s_lcd.bus = b;
+    if (!latch) return;
+
+    uint8_t nibble = b >> 4;
+    if (!s_lcd.half) {
+        s_lcd.high = nibble;
+        s_lcd.half = true;
+        return;
+    }
+    s_lcd.half = false;
+    uint8_t v = (s_lcd.high << 4) | nibble;
+    if (b & PCF_RS) lcd_data(v);
+    else lcd_command(v);
+    s_version++;
+}
+
+void sim_lcd_row(int row, char out[SIM_LCD_COLS + 1]) {
+    const uint8_t *line = &s_lcd.ddram[row ? 0x40 : 0x00];
+    for (int i = 0; i < SIM_LCD_COLS; i++) {
+        uint8_t c = line[i];
+        out[i] = (c >= 0x20 && c < 0x7F) ? (char)c : '?';
+    }
+    out[SIM_LCD_COLS] = '\0';
+}
+
+// ----------------------------------------------------------------------
+//  Branchement sur la HAL
+// ----------------------------------------------------------------------
+static void board_output(hal_pin_t pin, int level) {
+    for (int r = 0; r < 4; r++) {
+        if (s_row_pins[r] == pin) {
+            keypad_update();
+            return;
+        }
+    }
+    led_set(pin, level ? 255 : 0);
+}
+
+static void board_pwm(hal_pin_t pin, uint32_t duty, uint32_t fade_ms) {
+    led_set(pin, (uint8_t)(duty * 255 / HAL_PWM_DUTY_MAX));   // Cible du fondu
+}
+
+static bool board_i2c(uint8_t addr, const uint8_t *data, size_t len) {
+    if (addr != LCD_ADDR) return false;
+    for (size_t i = 0; i < len; i++) lcd_bus(data[i]);
+    return true;
+}
+
+static const hal_host_board_t s_board = {
+    .output = board_output,
+    .i2c_write = board_i2c,
+    .pwm = board_pwm,
+};
+
+void sim_board_init(void) {
+    memset(s_lcd.ddram, ' ', sizeof(s_lcd.ddram));
+    hal_host_attach(&s_board);
+}
+
+uint32_t sim_board_version(void) {
+    return s_version;
+}
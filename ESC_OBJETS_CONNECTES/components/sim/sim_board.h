@@ -0,0 +1,36 @@
+#ifndef SIM_BOARD_H
+#define SIM_BOARD_H
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----------------------------------------------------------------------
+//  Périphériques de la boîte branchés sur la HAL simulée
+// ----------------------------------------------------------------------
+#define SIM_LCD_ROWS 2
+#define SIM_LCD_COLS 16
+
+typedef enum {
+    SIM_LED_EP1,
+    SIM_LED_EP2,
+    SIM_LED_ERR,
+    SIM_LED_COUNT,
+} sim_led_t;
+
+void sim_board_init(void);
+uint32_t sim_board_version(void);      // Change à chaque modification visible
+
+bool sim_key(char key, bool pressed);  // false : touche absente du clavier
+void sim_button(bool pressed);
+
+uint8_t sim_led(sim_led_t led);        // Luminosité 0..255
+const char *sim_led_name(sim_led_t led);
+int sim_led_find(const char *name);    // -1 si inconnue
+
+// Ligne de l’écran ; les caractères personnalisés (CGRAM) valent '?'
+void sim_lcd_row(int row, char out[SIM_LCD_COLS + 1]);
+
+// Interfaces (sim_script.c, sim_tui.c)
+bool sim_script_run(const char *path);
+void sim_tui_run(void);
+
+#endif
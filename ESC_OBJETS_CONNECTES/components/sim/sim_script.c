@@ -0,0 +1,232 @@
+// ======================================================================
+//  Module : sim_script.c
+//  Description : Scénarios de test joués sur la carte simulée
+//  Fonctionnement :
+//     - Un fichier texte, une commande par ligne ('#' en début de ligne :
+//       commentaire). Les durées sont en millisecondes de temps simulé.
+//         wait <ms>                       attente
+//         key <touches>                   frappe chaque touche
+//         press <ms>                      appui sur le bouton
+//         morse <texte> [wpm]             texte tapé en Morse au bouton
+//         expect lcd <ligne> "<texte>" [ms]   début de ligne attendu
+//         expect led <ep1|ep2|err> <on|off> [ms]
+//         show                            affiche l’écran et les LEDs
+//         repeat <n> ... end              répétition (imbriquable)
+//     - expect attend au plus [ms] (1000 par défaut) que la condition
+//       soit vraie. Dans le texte attendu, '?' et tout caractère accentué
+//       acceptent n’importe quel caractère (CGRAM de l’écran).
+//     - La première vérification en échec arrête le scénario.
+// ======================================================================
+
+#include "sim_board.h"
+#include "hal_time.h"
+#include "morse.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "sim_script";
+
+#define SCRIPT_LINES_MAX   512
+#define SCRIPT_LINE_LEN    128
+#define SCRIPT_DEPTH       8
+#define KEY_HOLD_MS        150     // Au-delà de l’anti-rebond du clavier (100 ms)
+#define KEY_GAP_MS         100
+#define EXPECT_DEFAULT_MS  1000
+#define EXPECT_POLL_MS     10
+
+static char (*s_lines)[SCRIPT_LINE_LEN];
+static int s_count;
+
+// ----------------------------------------------------------------------
+//  Entrées
+// ----------------------------------------------------------------------
+static bool do_keys(const char *keys) {
+    for (; *keys; keys++) {
+        if (*keys == ' ') continue;
+        if (!sim_key(*keys, true)) {
+            ESP_LOGE(TAG, "Touche '%c' absente du clavier", *keys);
+            return false;
+        }
+        hal_delay_ms(KEY_HOLD_MS);
+        sim_key(*keys, false);
+        hal_delay_ms(KEY_GAP_MS);
+    }
+    return true;
+}
+
+static void do_press(uint32_t ms) {
+    sim_button(true);
+    hal_delay_ms(ms);
+    sim_button(false);
+}
+
+// Le texte est découpé en fronts par l’itérateur des LEDs
+static void do_morse(const char *text, unsigned wpm) {
+    morse_timing_t timing;
+    morse_iter_t it;
+    uint8_t level;
+    uint32_t duration_us;
+
+    morse_timing_init(&timing, wpm ? wpm : MORSE_DEFAULT_WPM, 0);
+    morse_iter_init(&it, &timing, text);
+    while (morse_iter_next(&it, &level, &duration_us)) {
+        sim_button(level);
+        hal_delay_ms(duration_us / 1000);
+    }
+    sim_button(false);
+}
+
+// ----------------------------------------------------------------------
+//  Vérifications
+// ----------------------------------------------------------------------
+// Début de ligne : '?' ou caractère UTF-8 non ASCII = joker
+static bool lcd_matches(int row, const char *expected) {
+    char line[SIM_LCD_COLS + 1];
+    sim_lcd_row(row, line);
+
+    const unsigned char *p = (const unsigned char *)expected;
+    for (int i = 0; *p; i++) {
+        if (i >= SIM_LCD_COLS) return false;
+        if (*p >= 0x80) {
+            p++;
+            while ((*p & 0xC0) == 0x80) p++;       // Octets de continuation
+            continue;
+        }
+        if (*p != '?' && *p != (unsigned char)line[i]) return false;
+        p++;
+    }
+    return true;
+}
+
+static void show(void) {
+    char line[SIM_LCD_COLS + 1];
+    for (int r = 0; r < SIM_LCD_ROWS; r++) {
+        sim_lcd_row(r, line);
+        printf("  |%s|\n", line);
+    }
+    for (int i = 0; i < SIM_LED_COUNT; i++) printf("  %s %3u", sim_led_name(i), sim_led(i));
+    printf("    t = %.3f s\n", hal_time_us() / 1e6);
+}
+
+typedef struct {
+    char kind;             // 'l' : écran, 'd' : LED
+    int index;             // Ligne ou LED
+    bool on;
+    const char *text;
+} expect_t;
+
+static bool expect_holds(const expect_t *e) {
+    if (e->kind == 'l') return lcd_matches(e->index, e->text);
+    return (sim_led(e->index) != 0) == e->on;
+}
+
+static bool do_expect(const expect_t *e, uint32_t timeout_ms) {
+    int64_t deadline = hal_time_us() + (int64_t)timeout_ms * 1000;
+    while (!expect_holds(e)) {
+        if (hal_time_us() >= deadline) return false;
+        hal_delay_ms(EXPECT_POLL_MS);
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Interprétation d’une ligne ; *pc pointe sur la ligne suivante
+// ----------------------------------------------------------------------
+static struct {
+    int line;              // Première ligne du bloc
+    int left;              // Tours restants
+} s_stack[SCRIPT_DEPTH];
+static int s_depth;
+
+static bool run_line(int *pc) {
+    int n = (*pc)++;
+    char *line = s_lines[n];
+    char cmd[16] = "", a[64] = "", b[64] = "";
+    unsigned ms = 0;
+
+    while (*line == ' ' || *line == '\t') line++;
+    if (*line == '\0' || *line == '#') return true;
+    sscanf(line, "%15s", cmd);
+    const char *args = line + strlen(cmd);
+    while (*args == ' ' || *args == '\t') args++;
+
+    if (strcmp(cmd, "wait") == 0 && sscanf(args, "%u", &ms) == 1) {
+        hal_delay_ms(ms);
+    } else if (strcmp(cmd, "key") == 0) {
+        return do_keys(args);
+    } else if (strcmp(cmd, "press") == 0 && sscanf(args, "%u", &ms) == 1) {
+        do_press(ms);
+    } else if (strcmp(cmd, "morse") == 0 && sscanf(args, "%63s %u", a, &ms) >= 1) {
+        do_morse(a, ms);
+    } else if (strcmp(cmd, "show") == 0) {
+        show();
+    } else if (strcmp(cmd, "expect") == 0) {
+        expect_t e = {0};
+        int row;
+        int used = 0;
+        if (sscanf(args, "lcd %d \"%63[^\"]\"%n", &row, b, &used) == 2 && row >= 0 && row < SIM_LCD_ROWS) {
+            e = (expect_t){.kind = 'l', .index = row, .text = b};
+        } else if (sscanf(args, "led %15s %15s%n", a, cmd, &used) == 2 && sim_led_find(a) >= 0) {
+            e = (expect_t){.kind = 'd', .index = sim_led_find(a), .on = strcmp(cmd, "on") == 0};
+        } else {
+            ESP_LOGE(TAG, "ligne %d : expect incompris", n + 1);
+            return false;
+        }
+        ms = EXPECT_DEFAULT_MS;
+        sscanf(args + used, "%u", &ms);
+        if (!do_expect(&e, ms)) {
+            ESP_LOGE(TAG, "ligne %d : échec de \"%s\"", n + 1, s_lines[n]);
+            show();
+            return false;
+        }
+    } else if (strcmp(cmd, "repeat") == 0 && sscanf(args, "%u", &ms) == 1 && s_depth < SCRIPT_DEPTH) {
+        s_stack[s_depth].line = *pc;
+        s_stack[s_depth].left = ms;
+        s_depth++;
+        if (ms == 0) {                             // Saute le bloc
+            int nest = 0;
+            for (; *pc < s_count; (*pc)++) {
+                if (strncmp(s_lines[*pc], "repeat", 6) == 0) nest++;
+                else if (strncmp(s_lines[*pc], "end", 3) == 0 && nest-- == 0) break;
+            }
+            (*pc)++;
+            s_depth--;
+        }
+    } else if (strcmp(cmd, "end") == 0 && s_depth > 0) {
+        if (--s_stack[s_depth - 1].left > 0) *pc = s_stack[s_depth - 1].line;
+        else s_depth--;
+    } else {
+        ESP_LOGE(TAG, "ligne %d : commande inconnue \"%s\"", n + 1, s_lines[n]);
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Joue un fichier ; retourne true si toutes les vérifications passent
+// ----------------------------------------------------------------------
+bool sim_script_run(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Scénario %s introuvable", path);
+        return false;
+    }
+
+    s_lines = calloc(SCRIPT_LINES_MAX, SCRIPT_LINE_LEN);
+    s_count = 0;
+    while (s_count < SCRIPT_LINES_MAX && fgets(s_lines[s_count], SCRIPT_LINE_LEN, f)) {
+        s_lines[s_count][strcspn(s_lines[s_count], "\r\n")] = '\0';
+        s_count++;
+    }
+    fclose(f);
+
+    ESP_LOGI(TAG, "%s : %d ligne(s)", path, s_count);
+    bool ok = true;
+    s_depth = 0;
+    for (int pc = 0; ok && pc < s_count;) ok = run_line(&pc);
+
+    free(s_lines);
+    return ok;
+}
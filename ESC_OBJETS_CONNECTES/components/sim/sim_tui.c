@@ -0,0 +1,153 @@
+// ======================================================================
+//  Module : sim_tui.c
+//  Description : Console interactive de la carte simulée
+//  Fonctionnement :
+//     - Terminal en mode brut : chaque caractère tapé est traité tout de
+//       suite. 0-9, A-D, * et # : touche du clavier (appui de 150 ms) ;
+//       '.' et '-' : point et trait au bouton ; 'q' : quitter.
+//     - Les frappes passent par une file : une touche tapée pendant
+//       qu’une autre est encore tenue attend son tour.
+//     - L’écran, les LEDs et l’heure sont redessinés (séquences ANSI)
+//       dès que la carte signale un changement.
+// ======================================================================
+
+#include "sim_board.h"
+#include "hal_time.h"
+#include "morse.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define TUI_PERIOD_MS  20
+#define KEY_HOLD_MS    150
+#define KEY_GAP_MS     100
+#define FIFO_SIZE      32
+
+static struct termios s_saved;
+
+static void term_restore(void) {
+    tcsetattr(STDIN_FILENO, TCSANOW, &s_saved);
+    printf("\033[?25h\n");                         // Curseur visible
+}
+
+static void term_raw(void) {
+    struct termios t;
+    tcgetattr(STDIN_FILENO, &s_saved);
+    t = s_saved;
+    t.c_lflag &= ~(ICANON | ECHO);                 // ISIG conservé : Ctrl-C reste actif
+    tcsetattr(STDIN_FILENO, TCSANOW, &t);
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+    atexit(term_restore);
+    printf("\033[2J\033[?25l");                    // Écran effacé, curseur masqué
+}
+
+// ----------------------------------------------------------------------
+//  Affichage
+// ----------------------------------------------------------------------
+static const char *const s_led_colors[SIM_LED_COUNT] = {"32", "34", "31"};   // Vert, bleu, rouge
+
+static void draw(void) {
+    char line[SIM_LCD_COLS + 1];
+
+    printf("\033[H");
+    printf("  +----------------+\n");
+    for (int r = 0; r < SIM_LCD_ROWS; r++) {
+        sim_lcd_row(r, line);
+        printf("  |%s|\n", line);
+    }
+    printf("  +----------------+\n\n ");
+    for (int i = 0; i < SIM_LED_COUNT; i++) {
+        uint8_t v = sim_led(i);
+        const char *style = v == 0 ? "90" : v < 128 ? "2;" : "1;";
+        if (v == 0) printf(" \033[90mo %s\033[0m", sim_led_name(i));
+        else printf(" \033[%s%sm● %s\033[0m", style, s_led_colors[i], sim_led_name(i));
+    }
+    printf("\n\n  t = %8.1f s\n\n", hal_time_us() / 1e6);
+    printf("  0-9 A-D * # : clavier   . - : bouton   q : quitter\033[K\n");
+    fflush(stdout);
+}
+
+// ----------------------------------------------------------------------
+//  Entrées : une action à la fois, tirée de la file
+// ----------------------------------------------------------------------
+static char s_fifo[FIFO_SIZE];
+static unsigned s_head, s_tail;
+
+typedef struct {
+    char c;                // Action en cours (0 : aucune)
+    bool held;             // Phase d’appui (sinon pause après relâchement)
+    int64_t until;         // Fin de la phase
+} action_t;
+
+static void action_start(action_t *a, const morse_timing_t *timing, int64_t now) {
+    if (s_head == s_tail) return;
+    a->c = s_fifo[s_tail++ % FIFO_SIZE];
+    a->held = true;
+    if (a->c == '.' || a->c == '-') {
+        sim_button(true);
+        a->until = now + (a->c == '.' ? timing->dot_us : timing->dash_us);
+    } else {
+        sim_key(a->c, true);
+        a->until = now + KEY_HOLD_MS * 1000;
+    }
+}
+
+static void action_step(action_t *a, const morse_timing_t *timing, int64_t now) {
+    if (a->c == 0) {
+        action_start(a, timing, now);
+        return;
+    }
+    if (now < a->until) return;
+    if (a->held) {
+        if (a->c == '.' || a->c == '-') {
+            sim_button(false);
+            a->until = now + timing->symbol_space_us;
+        } else {
+            sim_key(a->c, false);
+            a->until = now + KEY_GAP_MS * 1000;
+        }
+        a->held = false;
+    } else {
+        a->c = 0;
+        action_start(a, timing, now);
+    }
+}
+
+void sim_tui_run(void) {
+    morse_timing_t timing;
+    action_t action = {0};
+    uint32_t drawn = ~0u;
+
+    morse_timing_init(&timing, MORSE_DEFAULT_WPM, MORSE_DEFAULT_FARNSWORTH_WPM);
+    esp_log_level_set("*", ESP_LOG_WARN);          // Les logs brouilleraient l’affichage
+    term_raw();
+
+    int64_t last_second = -1;
+    for (;;) {
+        char c;
+        while (read(STDIN_FILENO, &c, 1) == 1) {
+            if (c == 'q') exit(0);
+            c = toupper((unsigned char)c);
+            bool known = c == '.' || c == '-' || isdigit((unsigned char)c) ||
+                         (c >= 'A' && c <= 'D') || c == '*' || c == '#';
+            if (known && s_head - s_tail < FIFO_SIZE) s_fifo[s_head++ % FIFO_SIZE] = c;
+        }
+
+        int64_t now = hal_time_us();
+        action_step(&action, &timing, now);
+
+        // Redessin sur changement, et chaque seconde pour l’heure
+        if (sim_board_version() != drawn || now / 1000000 != last_second) {
+            drawn = sim_board_version();
+            last_second = now / 1000000;
+            draw();
+        }
+        vTaskDelay(pdMS_TO_TICKS(TUI_PERIOD_MS));
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef SPSC_H
+#define SPSC_H
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "esp_attr.h"
+
+// ----------------------------------------------------------------------
+//  File circulaire sans verrou : un seul producteur, un seul consommateur
+//
+//  Le producteur n’écrit que head, le consommateur que tail ; chacun lit
+//  l’indice de l’autre avec une barrière d’acquisition et publie le sien
+//  avec une barrière de libération. Les deux côtés peuvent tourner sur
+//  des cœurs différents, et le producteur dans une ISR : ni section
+//  critique ni verrou tournant, aucun appel au noyau.
+//
+//  Capacité : puissance de 2. head et tail comptent sans fin ; leur
+//  différence est le nombre d’éléments en file (débordement sans effet).
+//  Fonctions forcées inline : utilisables depuis une ISR en IRAM.
+// ----------------------------------------------------------------------
+typedef struct {
+    uint8_t *buf;
+    uint32_t mask;             // Capacité - 1
+    uint32_t item_size;
+    _Atomic uint32_t head;     // Prochaine case écrite (producteur)
+    _Atomic uint32_t tail;     // Prochaine case lue (consommateur)
+} spsc_t;
+
+// Déclare une file statique de capacity éléments de type type
+#define SPSC_DEFINE(name, type, capacity)                                          \
+    _Static_assert(((capacity) & ((capacity) - 1)) == 0, "capacité : puissance de 2"); \
+    static type name##_items[capacity];                                            \
+    static spsc_t name = {.buf = (uint8_t *)name##_items, .mask = (capacity) - 1,  \
+                          .item_size = sizeof(type)}
+
+// Producteur : false si la file est pleine (rien n’est écrit)
+FORCE_INLINE_ATTR bool spsc_push(spsc_t *q, const void *item) {
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    if (head - tail > q->mask) return false;
+    memcpy(q->buf + (head & q->mask) * q->item_size, item, q->item_size);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+// Consommateur : élément en tête sans le retirer (NULL si la file est vide)
+FORCE_INLINE_ATTR const void *spsc_peek(spsc_t *q) {
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (head == tail) return NULL;
+    return q->buf + (tail & q->mask) * q->item_size;
+}
+
+// Consommateur : retire l’élément en tête (après spsc_peek)
+FORCE_INLINE_ATTR void spsc_drop(spsc_t *q) {
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+}
+
+// Consommateur : copie et retire l’élément en tête ; false si la file est vide
+FORCE_INLINE_ATTR bool spsc_pop(spsc_t *q, void *item) {
+    const void *front = spsc_peek(q);
+    if (front == NULL) return false;
+    memcpy(item, front, q->item_size);
+    spsc_drop(q);
+    return true;
+}
+
+#endif
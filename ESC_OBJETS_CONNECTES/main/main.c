@@ -8,9 +8,14 @@
 // ======================================================================
 
 #include "game_logic.h"        // Déclaration de launch_game()
+#include "boot_prof.h"         // Chronologie du démarrage
 #include "freertos/FreeRTOS.h" // OS temps réel de l’ESP32
 #include "freertos/task.h"
 #include "esp_log.h"           // Journalisation dans la console série
+#include "sdkconfig.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include "sim.h"               // Carte simulée (clavier, écran, LEDs)
+#endif
 
 // Tag de log pour identifier les messages dans le terminal
 static const char *TAG = "MAIN";
@@ -21,11 +26,17 @@ static const char *TAG = "MAIN";
 //  Elle est exécutée une seule fois au démarrage et tourne dans une tâche FreeRTOS.
 // ----------------------------------------------------------------------
 void app_main(void) {
+    boot_prof_mark("app_main");
     ESP_LOGI(TAG, "Démarrage du jeu...");
-    
-    // Lance la logique principale du jeu (boucle keypad/LCD/LED)
+
+#if CONFIG_IDF_TARGET_LINUX
+    // Périphériques et flash de la carte simulée, avant les pilotes
+    sim_start();
+#endif
+
+    // Initialise les périphériques et lance la tâche du jeu (boucle keypad/LCD/LED)
     launch_game();
 
-    // Si launch_game() se termine, le programme atteindra ce point.
-    ESP_LOGI(TAG, "Le jeu est terminé, app_main() quitte.");
+    // Le jeu tourne dans sa propre tâche : app_main() peut se terminer.
+    ESP_LOGI(TAG, "Jeu lancé, app_main() quitte.");
 }
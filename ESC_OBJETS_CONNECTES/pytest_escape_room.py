@@ -0,0 +1,195 @@
+# ======================================================================
+#  Tests de bout en bout du firmware, sans carte
+#
+#  QEMU esp32 (profil sdkconfig.ci.qemu, CONFIG_GAME_TEST_IO) : les touches
+#  et le bouton sont envoyés sur la console, l’écran est relu dans les
+#  lignes "TESTIO lcd" (voir test_io.h), qui donnent aussi les latences.
+#
+#  Cible linux : les scénarios sim/*.sim sont joués sur la carte simulée.
+#
+#     idf.py -B build_esp32_qemu -D SDKCONFIG=build_esp32_qemu/sdkconfig \
+#            -D SDKCONFIG_DEFAULTS="sdkconfig.defaults;sdkconfig.ci.qemu" set-target esp32 build
+#     idf.py -B build_esp32_qemu_fastboot -D SDKCONFIG=build_esp32_qemu_fastboot/sdkconfig \
+#            -D SDKCONFIG_DEFAULTS="sdkconfig.defaults;sdkconfig.ci.qemu;sdkconfig.fastboot" \
+#            set-target esp32 build                 (test_boot_breakdown seulement)
+#     pytest pytest_escape_room.py --target esp32 -m qemu
+#     idf.py -B build_linux --preview set-target linux build
+#     pytest pytest_escape_room.py --target linux -m host_test --build-dir build_linux
+# ======================================================================
+import os
+import re
+import subprocess
+from pathlib import Path
+
+import pytest
+from pytest_embedded_idf.app import IdfApp
+from pytest_embedded_idf.utils import idf_parametrize
+from pytest_embedded_qemu.dut import QemuDut
+
+PROJECT_DIR = Path(__file__).parent
+
+# Budgets de temps (µs, horloge du firmware)
+BOOT_TO_PROMPT_US = 3_000_000     # Démarrage → "Entrez le code:" affiché
+KEY_TO_ECHO_US = 50_000           # Touche reçue → chiffre affiché
+CODE_TO_VERDICT_US = 150_000      # Dernière touche → "Nope!" / réussite
+
+LCD_LINE = re.compile(rb'TESTIO lcd t=(\d+) lat=(-?\d+) \|(.{16})\|(.{16})\|')
+# Bilan du démarrage (boot_prof.c) : une ligne par étape, puis le total
+BOOT_LINE = re.compile(rb'boot: (?:Invite affich\S+ (\d+\.\d) ms|\S+ +\d+\.\d ms  \([^)]*\))')
+
+
+class Screen:
+    """Dernier écran relu sur la console."""
+
+    def __init__(self, dut: QemuDut) -> None:
+        self.dut = dut
+        self.t_us = self.lat_us = 0
+        self.rows = ['', '']
+
+    def wait(self, row: int, text: str, timeout: float = 5) -> 'Screen':
+        """Attend que la ligne row commence par text ('?' : caractère personnalisé).
+        L’écran courant compte : une condition déjà remplie rend la main tout de suite."""
+        pattern = re.compile(re.escape(text).replace(r'\?', '.'))
+        if pattern.match(self.rows[row]):
+            return self
+        while True:
+            m = self.dut.expect(LCD_LINE, timeout=timeout)
+            self.t_us, self.lat_us = int(m.group(1)), int(m.group(2))
+            self.rows = [m.group(3).decode('ascii'), m.group(4).decode('ascii')]
+            if pattern.match(self.rows[row]):
+                return self
+
+    def key(self, keys: str) -> None:
+        self.dut.write(f'key {keys}')
+
+    def button(self, pressed: bool) -> None:
+        self.dut.write(f'button {int(pressed)}')
+
+    def morse(self, text: str) -> None:
+        self.dut.write(f'morse {text}')
+
+
+@pytest.fixture
+def screen(dut: QemuDut) -> Screen:
+    dut.expect_exact('TESTIO ready', timeout=30)
+    s = Screen(dut)
+    s.wait(0, 'Entrez le code:', timeout=30)
+    return s
+
+
+# ----------------------------------------------------------------------
+#  QEMU esp32
+# ----------------------------------------------------------------------
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.parametrize('config', ['qemu'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_boot_to_prompt(screen: Screen) -> None:
+    assert screen.lat_us == -1, 'premier affichage attendu au démarrage'
+    assert screen.t_us < BOOT_TO_PROMPT_US, f'invite affichée à {screen.t_us} µs'
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.parametrize('config', ['qemu', 'qemu_fastboot'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_boot_breakdown(screen: Screen, app: IdfApp) -> None:
+    """Relève le bilan "boot" dans <build>/boot.log (tools/boot_compare.py)."""
+    lines = []
+    while True:
+        m = screen.dut.expect(BOOT_LINE, timeout=5)
+        lines.append(m.group(0).decode('utf-8', errors='replace'))
+        if m.group(1) is not None:
+            break
+    Path(app.binary_path, 'boot.log').write_text('\n'.join(lines) + '\n', encoding='utf-8')
+    assert float(m.group(1)) * 1000 < BOOT_TO_PROMPT_US, lines[-1]
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.parametrize('config', ['qemu'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_key_echo(screen: Screen) -> None:
+    for i, k in enumerate('123'):
+        screen.key(k)
+        screen.wait(1, '123'[:i + 1])
+        assert screen.lat_us < KEY_TO_ECHO_US, f'écho de {k} en {screen.lat_us} µs'
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.parametrize('config', ['qemu'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_wrong_code(screen: Screen) -> None:
+    for k in '1234':
+        screen.key(k)
+        screen.wait(1, '1234'[:'1234'.index(k) + 1])
+    screen.key('5')
+    screen.wait(0, 'Nope!')
+    assert screen.lat_us < CODE_TO_VERDICT_US, f'verdict en {screen.lat_us} µs'
+    screen.wait(0, 'Entrez le code:')          # Après 2,5 s
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.parametrize('config', ['qemu'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_success(screen: Screen) -> None:
+    for i, k in enumerate('B947'):
+        screen.key(k)
+        screen.wait(1, 'B947'[:i + 1])
+    screen.key('D')
+    screen.wait(0, 'R?ussite!')                # é : caractère personnalisé
+    assert screen.lat_us < CODE_TO_VERDICT_US, f'verdict en {screen.lat_us} µs'
+    assert screen.rows[1] == 'Wait for part 2!'
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.parametrize('config', ['qemu'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_morse_part2(screen: Screen) -> None:
+    screen.key('B947D')
+    screen.wait(0, 'R?ussite!')
+    screen.wait(0, 'Morse au bouton:')
+    screen.key('SOS')                          # Clavier ignoré : code attendu au bouton
+    screen.morse('SOT')
+    screen.wait(0, 'Nope!')
+    screen.wait(0, 'Morse au bouton:')
+    screen.morse('SOS')
+    screen.wait(0, 'Bravo!')
+    assert screen.lat_us < CODE_TO_VERDICT_US, f'verdict en {screen.lat_us} µs'
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@pytest.mark.parametrize('config', ['qemu'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_lockout(screen: Screen) -> None:
+    for attempt in range(3):
+        for i, k in enumerate('1111'):
+            screen.key(k)
+            screen.wait(1, '1111'[:i + 1])
+        screen.key('1')
+        screen.wait(0, 'Nope!')
+        if attempt < 2:
+            screen.wait(0, 'Entrez le code:')
+    screen.wait(1, 'Pause  30s')               # Affiché avec le 3ᵉ "Nope!"
+    screen.key('B')                            # Refusée pendant le blocage
+    screen.wait(1, 'Pause  28s')
+    assert not screen.rows[1].startswith('B')
+
+
+# ----------------------------------------------------------------------
+#  Cible linux : scénarios de la carte simulée
+# ----------------------------------------------------------------------
+@pytest.mark.host_test
+@pytest.mark.parametrize('script', sorted(p.name for p in (PROJECT_DIR / 'sim').glob('*.sim')))
+@idf_parametrize('target', ['linux'], indirect=['target'])
+def test_sim_script(app: IdfApp, script: str) -> None:
+    env = dict(os.environ,
+               SIM_SCRIPT=str(PROJECT_DIR / 'sim' / script),
+               SIM_ASSETS=os.path.join(app.binary_path, 'assets.bin'))
+    run = subprocess.run([app.elf_file], env=env, cwd=PROJECT_DIR, timeout=300,
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, errors='replace')
+    assert run.returncode == 0, run.stdout[-4000:]
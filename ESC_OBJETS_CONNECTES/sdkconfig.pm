@@ -0,0 +1,4 @@
+# Profil mesure d’énergie : temps passé à chaque fréquence et durée de
+# prise de chaque verrou, affichés toutes les 60 s (power.c)
+CONFIG_PM_PROFILING=y
+CONFIG_GAME_PM_REPORT_S=60
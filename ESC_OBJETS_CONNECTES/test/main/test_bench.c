@@ -0,0 +1,201 @@
+// ======================================================================
+//  Fichier : test_bench.c
+//  Description : Mesure des chemins critiques des pilotes
+//  Fonctionnement :
+//      - Chaque mesure est un TEST_CASE "[bench]" : n appels chronométrés
+//        un par un avec hal_cycles(), n choisi par mesure (un lcd_print
+//        coûte ~45 ms d’attentes HD44780, un keypad_scan quelques µs).
+//      - Unité : cycles CPU (esp_cpu_get_cycle_count) sur ESP32 et sous
+//        QEMU, nanosecondes réelles sur la cible linux (HAL_CYCLES_UNIT).
+//      - Les durées triées donnent médiane, p99 et maximum ; la durée
+//        totale (hal_time_us) donne la moyenne en ns. Un premier appel
+//        non compté remplit les caches.
+//      - Chaque mesure vérifie aussi l’effet des appels (clavier au
+//        repos, texte affiché, attentes du protocole LCD, état des LEDs).
+//      - Résultats en JSON sur une ligne "BENCH ...", à comparer à une
+//        référence avec tools/bench_compare.py.
+// ======================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "hal_time.h"
+#include "keypad.h"
+#include "lcd.h"
+#include "led.h"
+#include "led_effects.h"
+#include "morse.h"
+#include "sdkconfig.h"
+
+#define BENCH_MAX 1000                    // Appels mesurés au plus
+
+// Attentes actives du protocole HD44780 dans le pilote (lcd.c) :
+// impulsion EN 2 × 600 µs, un octet = deux impulsions, + 600 µs après
+// un caractère. Les 2 ms d’une commande passent par vTaskDelay (tick
+// déjà entamé) et ne comptent pas dans le minimum.
+#define LCD_PULSE_US (2 * 600)
+#define LCD_CMD_MIN_US (2 * LCD_PULSE_US)
+#define LCD_CHAR_MIN_US (2 * LCD_PULSE_US + 600)
+
+typedef void (*bench_fn_t)(int i);
+
+typedef struct {
+    uint32_t p50;                         // Unité HAL_CYCLES_UNIT
+    uint32_t p99;
+    uint32_t max;
+    int64_t mean_ns;
+} bench_result_t;
+
+static uint32_t s_samples[BENCH_MAX];
+static volatile uint32_t s_sink;          // Résultats consommés : rien n’est optimisé
+static morse_timing_t s_timing;
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// ----------------------------------------------------------------------
+//  Chronomètre n appels de fn et publie la ligne de résultats
+// ----------------------------------------------------------------------
+static bench_result_t bench_measure(const char *name, bench_fn_t fn, int n) {
+    TEST_ASSERT_TRUE(n > 0 && n <= BENCH_MAX);
+    fn(0);
+
+    int64_t t0 = hal_time_us();
+    for (int i = 0; i < n; i++) {
+        uint32_t c0 = hal_cycles();
+        fn(i);
+        s_samples[i] = hal_cycles() - c0;
+    }
+    int64_t total_us = hal_time_us() - t0;
+
+    qsort(s_samples, n, sizeof(s_samples[0]), cmp_u32);
+    bench_result_t r = {
+        .p50 = s_samples[n / 2],
+        .p99 = s_samples[(n * 99 + 99) / 100 - 1],      // Rang le plus proche
+        .max = s_samples[n - 1],
+        .mean_ns = total_us * 1000 / n,
+    };
+    printf("BENCH {\"target\":\"%s\",\"name\":\"%s\",\"unit\":\"%s\",\"n\":%d,"
+           "\"p50\":%lu,\"p99\":%lu,\"max\":%lu,\"mean_ns\":%lld}\n",
+           CONFIG_IDF_TARGET, name, HAL_CYCLES_UNIT, n, (unsigned long)r.p50,
+           (unsigned long)r.p99, (unsigned long)r.max, (long long)r.mean_ns);
+    return r;
+}
+
+// Initialisation des pilotes, une fois pour toutes les mesures
+static void bench_setup(void) {
+    static bool ready = false;
+    if (ready) return;
+    leds_init();
+    lcd_i2c_init();
+    lcd_init();
+    keypad_init();
+    morse_timing_init(&s_timing, MORSE_DEFAULT_WPM, MORSE_DEFAULT_FARNSWORTH_WPM);
+    ready = true;
+}
+
+// ----------------------------------------------------------------------
+//  Appels mesurés
+// ----------------------------------------------------------------------
+static void call_empty(int i) {
+}
+
+static void call_keypad_scan(int i) {
+    s_sink += keypad_scan();                       // Aucune touche : 4 lignes balayées
+}
+
+static void call_lcd_set_cursor(int i) {
+    lcd_set_cursor(i & 1, 0);                      // Autre ligne : une commande à chaque appel
+}
+
+static void call_lcd_print(int i) {
+    lcd_print("Entrez le code:");
+}
+
+static void call_morse_iter(int i) {
+    morse_iter_t it;
+    uint8_t level;
+    uint32_t duration_us, total_us = 0;
+
+    morse_iter_init(&it, &s_timing, "b947d");
+    while (morse_iter_next(&it, &level, &duration_us)) total_us += duration_us;
+    s_sink = total_us;
+}
+
+static void call_leds_set(int i) {
+    if (i & 1) leds_set(LED_EP1, 0);
+    else leds_set(0, LED_EP1);
+}
+
+static void call_led_brightness(int i) {
+    led_set_brightness(get_led_ep2(), (uint8_t)i);
+}
+
+// ----------------------------------------------------------------------
+//  Mesures
+// ----------------------------------------------------------------------
+TEST_CASE("bench hal_cycles : coût de la mesure", "[bench]") {
+    bench_result_t r = bench_measure("hal_cycles", call_empty, 1000);
+    TEST_ASSERT_LESS_THAN_UINT32(1000, r.p50);     // Compris dans toutes les autres lignes
+}
+
+TEST_CASE("bench keypad_scan : clavier au repos", "[bench]") {
+    bench_setup();
+    s_sink = 0;
+    bench_result_t r = bench_measure("keypad_scan", call_keypad_scan, 1000);
+    TEST_ASSERT_EQUAL_UINT32(0, s_sink);           // Aucune touche lue
+    TEST_ASSERT_LESS_THAN_INT32(1000000, (int32_t)r.mean_ns);   // Sans délai anti-rebond
+}
+
+TEST_CASE("bench lcd_set_cursor : une commande par déplacement", "[bench]") {
+    bench_setup();
+    bench_result_t r = bench_measure("lcd_set_cursor", call_lcd_set_cursor, 200);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT32(LCD_CMD_MIN_US * 1000, (int32_t)r.mean_ns);
+
+    // Curseur déjà en place : aucune commande envoyée
+    int64_t t0 = hal_time_us();
+    lcd_set_cursor(1, 0);
+    TEST_ASSERT_LESS_THAN_INT32(LCD_PULSE_US, (int32_t)(hal_time_us() - t0));
+}
+
+TEST_CASE("bench lcd_print : 15 caractères", "[bench]") {
+    static const char text[] = "Entrez le code:";
+    char row[LCD_COLS + 1];
+
+    bench_setup();
+    lcd_clear();                                   // Premier appel (non compté) en 0,0
+    bench_result_t r = bench_measure("lcd_print", call_lcd_print, 20);
+    lcd_framebuffer(0, row);
+    TEST_ASSERT_EQUAL_MEMORY(text, row, sizeof(text) - 1);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT32((int32_t)(sizeof(text) - 1) * LCD_CHAR_MIN_US * 1000, (int32_t)r.mean_ns);
+}
+
+TEST_CASE("bench morse_iter : découpage de \"b947d\"", "[bench]") {
+    morse_timing_init(&s_timing, MORSE_DEFAULT_WPM, MORSE_DEFAULT_FARNSWORTH_WPM);
+    bench_measure("morse_iter", call_morse_iter, 1000);
+
+    // -... ----. ....- --... -.. : 13 points, 9 tirets, 17 pauses entre
+    // symboles, 5 pauses de lettre (dont celle qui suit le "d")
+    uint32_t message_us = 13 * s_timing.dot_us + 9 * s_timing.dash_us + 17 * s_timing.symbol_space_us
+                        + 5 * s_timing.letter_space_us;
+    TEST_ASSERT_EQUAL_UINT32(message_us, s_sink);
+}
+
+TEST_CASE("bench leds_set : tout-ou-rien", "[bench]") {
+    bench_setup();
+    bench_measure("leds_set", call_leds_set, 1000);
+    TEST_ASSERT_EQUAL_UINT32(LED_EP1, leds_state() & LED_EP1);   // Dernier appel (999) : allumée
+    leds_set(0, LED_EP1);
+    TEST_ASSERT_EQUAL_UINT32(0, leds_state() & LED_EP1);
+}
+
+TEST_CASE("bench led_set_brightness : LED en PWM", "[bench]") {
+    bench_setup();
+    bench_measure("led_set_brightness", call_led_brightness, 1000);
+    TEST_ASSERT_EQUAL_UINT32(LED_EP2, led_effects_busy() & LED_EP2);
+    led_effect_stop(get_led_ep2());
+    TEST_ASSERT_EQUAL_UINT32(0, led_effects_busy() & LED_EP2);     // Broche rendue au GPIO
+}
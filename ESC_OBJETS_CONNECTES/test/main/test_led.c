@@ -0,0 +1,135 @@
+// ======================================================================
+//  Fichier : test_led.c
+//  Description : Tests de l’ordonnanceur des effets (composant led)
+//  Fonctionnement :
+//      - Trois messages Morse sont joués en même temps par led_sched,
+//        comme sur les trois LEDs, avec des sondes à la place des
+//        effets : chaque front relève son retard sur l’échéance prévue.
+//      - Les échéances sont absolues : le retard d’un front ne se
+//        reporte pas sur les suivants, la fin du message tombe à
+//        l’instant de départ + durée calculée par l’itérateur.
+//      - Un effet sans boucle qui finit allumé ou éteint rend la LED au
+//        tout-ou-rien : plus de PWM ni de verrous d’énergie.
+// ======================================================================
+
+#include <stdio.h>
+#include "unity.h"
+#include "led.h"
+#include "led_effects.h"
+#include "led_sched.h"
+#include "morse.h"
+#include "hal_time.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+// Retard moyen toléré : quelques ticks sur la cible linux (horloge de la
+// carte simulée servie à chaque tick), latence d’esp_timer sinon. Sur
+// linux un front isolé peut attendre l’ordonnanceur de l’hôte : seul le
+// retard moyen y est borné, le maximum est affiché.
+#if CONFIG_IDF_TARGET_LINUX
+#define DRIFT_MAX_US 5000
+#else
+#define DRIFT_MAX_US 2000
+#endif
+#define PROBE_COUNT 3
+
+typedef struct {
+    led_sched_entry_t entry;              // En tête : conversion entrée → sonde
+    morse_timing_t timing;
+    morse_iter_t it;
+    int64_t end_us;                       // Échéance du dernier front
+    int64_t finished_us;                  // Instant où il a été servi
+    int32_t min_late_us;                  // Retard des fronts sur leur échéance
+    int32_t max_late_us;
+    int64_t sum_late_us;
+    int edges;
+    TaskHandle_t waiter;
+} drift_probe_t;
+
+static int64_t probe_step(led_sched_entry_t *entry, int64_t deadline_us) {
+    drift_probe_t *p = (drift_probe_t *)entry;
+    int64_t now = hal_time_us();
+    uint8_t level;
+    uint32_t duration_us;
+
+    int32_t late = (int32_t)(now - deadline_us);
+    if (late < p->min_late_us) p->min_late_us = late;
+    if (late > p->max_late_us) p->max_late_us = late;
+    p->sum_late_us += late;
+    if (!morse_iter_next(&p->it, &level, &duration_us)) {
+        p->end_us = deadline_us;
+        p->finished_us = now;
+        xTaskNotifyGive(p->waiter);
+        return LED_SCHED_DONE;
+    }
+    p->edges++;
+    return deadline_us + duration_us;
+}
+
+// Durée calculée du message
+static uint64_t probe_total_us(const morse_timing_t *timing, const char *msg) {
+    morse_iter_t it;
+    uint8_t level;
+    uint32_t duration_us;
+    uint64_t total = 0;
+
+    morse_iter_init(&it, timing, msg);
+    while (morse_iter_next(&it, &level, &duration_us)) total += duration_us;
+    return total;
+}
+
+TEST_CASE("Morse sur led_sched : dérive bornée, sans cumul", "[led]") {
+    static const char *const msgs[PROBE_COUNT] = {"PARIS PARIS PARIS", "B947D B947D", "SOS SOS SOS SOS"};
+    static const unsigned wpm[PROBE_COUNT][2] = {{40, 0}, {30, 20}, {25, 0}};
+    static drift_probe_t probes[PROBE_COUNT];
+
+    led_sched_init();
+    int64_t start = hal_time_us() + 10000;
+    led_sched_lock();
+    for (int i = 0; i < PROBE_COUNT; i++) {
+        drift_probe_t *p = &probes[i];
+        *p = (drift_probe_t){.waiter = xTaskGetCurrentTaskHandle(), .min_late_us = INT32_MAX};
+        morse_timing_init(&p->timing, wpm[i][0], wpm[i][1]);
+        morse_iter_init(&p->it, &p->timing, msgs[i]);
+        p->entry.step = probe_step;
+        led_sched_start(&p->entry, start);
+    }
+    led_sched_unlock();
+
+    for (int done = 0; done < PROBE_COUNT;) {
+        TEST_ASSERT_TRUE_MESSAGE(ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(20000)) > 0, "message Morse non terminé");
+        done++;
+    }
+
+    for (int i = 0; i < PROBE_COUNT; i++) {
+        const drift_probe_t *p = &probes[i];
+        int32_t mean_late_us = (int32_t)(p->sum_late_us / (p->edges + 1));
+        printf("%-18s %2u/%2u WPM : %3d fronts, retard %ld..%ld us (moyen %ld), fin à +%ld us\n",
+               msgs[i], wpm[i][0], wpm[i][1], p->edges, (long)p->min_late_us, (long)p->max_late_us,
+               (long)mean_late_us, (long)(p->finished_us - p->end_us));
+        // Dernière échéance = départ + somme des durées : aucun retard cumulé
+        TEST_ASSERT_EQUAL_INT32(0, (int32_t)(p->end_us - start - (int64_t)probe_total_us(&p->timing, msgs[i])));
+        TEST_ASSERT_GREATER_OR_EQUAL_INT32(0, p->min_late_us);   // Jamais en avance
+        TEST_ASSERT_LESS_OR_EQUAL_INT32(DRIFT_MAX_US, mean_late_us);
+#if !CONFIG_IDF_TARGET_LINUX
+        TEST_ASSERT_LESS_OR_EQUAL_INT32(DRIFT_MAX_US, p->max_late_us);
+#endif
+    }
+}
+
+TEST_CASE("Effets sans boucle : LED rendue au tout-ou-rien", "[led]") {
+    Led *led = get_led_ep1();
+
+    leds_init();
+    led_effect_start(led, &LED_EFFECT_SUCCESS);
+    TEST_ASSERT_EQUAL_UINT32(LED_EP1, led_effects_busy());
+    led_effect_wait(led);
+    TEST_ASSERT_EQUAL_UINT32(0, led_effects_busy());         // Verrous APB et sommeil rendus
+    TEST_ASSERT_TRUE(led_is_on(led));                        // Dernière étape : 255
+
+    led_effect_start(led, &LED_EFFECT_ERROR);
+    led_effect_wait(led);
+    TEST_ASSERT_EQUAL_UINT32(0, led_effects_busy());
+    TEST_ASSERT_FALSE(led_is_on(led));                       // Dernière étape : 0
+}
@@ -0,0 +1,25 @@
+// ======================================================================
+//  Fichier : test_main.c
+//  Description : Point d’entrée de l’application de tests
+//  Fonctionnement :
+//      - Exécute tous les TEST_CASE liés (un fichier par composant).
+//      - Le bilan Unity ("N Tests F Failures I Ignored") est relu par
+//        pytest_unit.py ; sur la cible linux, le code de sortie vaut 1
+//        en cas d’échec.
+// ======================================================================
+
+#include <stdlib.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+void app_main(void) {
+    UNITY_BEGIN();
+    unity_run_all_tests();
+    int failures = UNITY_END();
+
+#if CONFIG_IDF_TARGET_LINUX
+    exit(failures ? EXIT_FAILURE : EXIT_SUCCESS);
+#else
+    (void)failures;
+#endif
+}
@@ -0,0 +1,214 @@
+// ======================================================================
+//  Fichier : test_morse.c
+//  Description : Tests du composant morse (durées, décodeur)
+//  Fonctionnement :
+//      - Durées : la somme des fronts d’un long message suit la
+//        référence "PARIS " (50 unités par mot), Farnsworth compris.
+//      - Décodeur : les fronts d’un message sont produits par l’itérateur du
+//        composant (celui des LEDs) puis rejoués dans le décodeur, avec
+//        la minuterie de fin de lettre / de mot de push_button.c simulée
+//        à partir de morse_decoder_deadline().
+//      - Le décodeur part toujours de sa vitesse par défaut (point de
+//        200 ms) : il doit suivre un joueur plus rapide ou Farnsworth.
+// ======================================================================
+
+#include <string.h>
+#include "unity.h"
+#include "morse.h"
+
+#define DECODED_MAX 64
+#define PARIS_UNITS 50                    // Unités d’un mot "PARIS " (espace compris)
+#define PARIS_WORDS 100
+
+// ----------------------------------------------------------------------
+//  Durées
+// ----------------------------------------------------------------------
+// Durée totale d’un message et nombre de fronts
+// (moins de 4295 s : les totaux tiennent sur 32 bits)
+static uint32_t message_us(const morse_timing_t *timing, const char *msg, int *edges) {
+    morse_iter_t it;
+    uint8_t level;
+    uint32_t duration_us;
+    uint32_t total = 0;
+
+    *edges = 0;
+    morse_iter_init(&it, timing, msg);
+    while (morse_iter_next(&it, &level, &duration_us)) {
+        TEST_ASSERT_EQUAL(*edges % 2 == 0, level);   // Allumage et extinction alternés
+        total += duration_us;
+        (*edges)++;
+    }
+    return total;
+}
+
+static const char *paris_words(void) {
+    static char text[PARIS_WORDS * 6 + 1];
+    for (int i = 0; i < PARIS_WORDS; i++) memcpy(&text[i * 6], "PARIS ", 6);
+    text[PARIS_WORDS * 6] = '\0';
+    return text;
+}
+
+TEST_CASE("durée d’un message : 50 unités par \"PARIS \"", "[morse]") {
+    static const unsigned wpm[] = {MORSE_DEFAULT_WPM, 5, 7, 13, 20, 40};
+    const char *text = paris_words();
+    morse_timing_t timing;
+    int edges;
+
+    // 6 WPM : point de 200 ms, 10 s par mot
+    morse_timing_init(&timing, MORSE_DEFAULT_WPM, 0);
+    TEST_ASSERT_EQUAL_UINT32(200000, timing.dot_us);
+    TEST_ASSERT_EQUAL_UINT32(10000000, message_us(&timing, "PARIS ", &edges));
+    TEST_ASSERT_EQUAL_INT(2 * 14, edges);                 // 14 symboles
+
+    for (size_t i = 0; i < sizeof(wpm) / sizeof(wpm[0]); i++) {
+        morse_timing_init(&timing, wpm[i], 0);
+        TEST_ASSERT_EQUAL_UINT32(PARIS_WORDS * PARIS_UNITS * timing.dot_us,
+                                 message_us(&timing, text, &edges));
+        TEST_ASSERT_EQUAL_INT(PARIS_WORDS * 2 * 14, edges);
+    }
+}
+
+TEST_CASE("durée d’un message Farnsworth : vitesse globale tenue", "[morse]") {
+    static const unsigned speeds[][2] = {{20, 5}, {18, 10}, {15, 8}, {12, 6}};
+    morse_timing_t timing;
+    int edges;
+
+    for (size_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+        morse_timing_init(&timing, speeds[i][0], speeds[i][1]);
+        TEST_ASSERT_EQUAL_UINT32(1200000u / speeds[i][0], timing.dot_us);   // Caractères à pleine vitesse
+
+        // 60 s / wpm global par mot ; durées arrondies à la µs : 31 points
+        // et 5 espaces par mot, 40 µs d’écart par mot au plus
+        uint32_t expected = 60000000u / speeds[i][1] * PARIS_WORDS;
+        TEST_ASSERT_UINT32_WITHIN(40 * PARIS_WORDS, expected, message_us(&timing, paris_words(), &edges));
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Décodeur
+// ----------------------------------------------------------------------
+
+typedef struct {
+    morse_decoder_t dec;
+    int64_t now_us;                       // Horloge simulée
+    char text[DECODED_MAX];
+    int len;
+} morse_player_t;
+
+static void player_init(morse_player_t *p) {
+    morse_decoder_init(&p->dec, 0);
+    p->now_us = 1000000;
+    p->len = 0;
+    p->text[0] = '\0';
+}
+
+static void player_push(morse_player_t *p, const char *out, int n) {
+    for (int i = 0; i < n && p->len < DECODED_MAX - 1; i++) p->text[p->len++] = out[i];
+    p->text[p->len] = '\0';
+}
+
+// Minuterie : échéances atteintes avant l’instant t
+static void player_timeouts(morse_player_t *p, int64_t t_us) {
+    char out[2];
+    for (int64_t deadline; (deadline = morse_decoder_deadline(&p->dec)) >= 0 && deadline <= t_us;) {
+        int n = morse_decoder_poll(&p->dec, deadline, out);
+        player_push(p, out, n);
+        if (n == 0) break;
+    }
+}
+
+static void player_edge(morse_player_t *p, bool pressed) {
+    char out[2];
+    player_timeouts(p, p->now_us);
+    player_push(p, out, morse_decoder_edge(&p->dec, pressed, p->now_us, out));
+}
+
+// Joue un message au clavier Morse, à la vitesse donnée
+static void player_send(morse_player_t *p, const char *msg, unsigned wpm, unsigned farnsworth_wpm) {
+    morse_timing_t timing;
+    morse_iter_t it;
+    uint8_t level;
+    uint32_t duration_us;
+
+    morse_timing_init(&timing, wpm, farnsworth_wpm);
+    morse_iter_init(&it, &timing, msg);
+    while (morse_iter_next(&it, &level, &duration_us)) {
+        player_edge(p, level);
+        p->now_us += duration_us;
+    }
+}
+
+// Silence final : le joueur s’arrête, la minuterie termine lettre et mot
+static const char *player_stop(morse_player_t *p) {
+    player_timeouts(p, p->now_us + 60000000);
+    if (p->len > 0 && p->text[p->len - 1] == ' ') p->text[--p->len] = '\0';
+    return p->text;
+}
+
+static const char *decode(const char *msg, unsigned wpm, unsigned farnsworth_wpm) {
+    static morse_player_t p;
+    player_init(&p);
+    player_send(&p, msg, wpm, farnsworth_wpm);
+    return player_stop(&p);
+}
+
+TEST_CASE("décodage à la vitesse par défaut", "[morse]") {
+    TEST_ASSERT_EQUAL_STRING("SOS", decode("SOS", MORSE_DEFAULT_WPM, 0));
+    TEST_ASSERT_EQUAL_STRING("PARIS PARIS", decode("PARIS PARIS", MORSE_DEFAULT_WPM, 0));
+    TEST_ASSERT_EQUAL_STRING("B947D", decode("B947D", MORSE_DEFAULT_WPM, 0));
+}
+
+TEST_CASE("décodage d’un joueur à 20 WPM", "[morse]") {
+    TEST_ASSERT_EQUAL_STRING("SOS", decode("SOS", 20, 0));
+    TEST_ASSERT_EQUAL_STRING("B947D", decode("B947D", 20, 0));
+    TEST_ASSERT_EQUAL_STRING("PARIS PARIS", decode("PARIS PARIS", 20, 0));
+}
+
+TEST_CASE("décodage d’autres vitesses", "[morse]") {
+    static const unsigned wpm[] = {5, 9, 10, 12, 15, 30};
+    for (size_t i = 0; i < sizeof(wpm) / sizeof(wpm[0]); i++) {
+        TEST_ASSERT_EQUAL_STRING("SOS", decode("SOS", wpm[i], 0));
+        TEST_ASSERT_EQUAL_STRING("HELLO WORLD", decode("HELLO WORLD", wpm[i], 0));
+    }
+}
+
+TEST_CASE("décodage Farnsworth 20/5 WPM", "[morse]") {
+    TEST_ASSERT_EQUAL_STRING("SOS", decode("SOS", 20, 5));
+    TEST_ASSERT_EQUAL_STRING("B947D", decode("B947D", 20, 5));
+    TEST_ASSERT_EQUAL_STRING("PARIS PARIS", decode("PARIS PARIS", 20, 5));
+    TEST_ASSERT_EQUAL_STRING("HELLO WORLD", decode("HELLO WORLD", 15, 8));
+}
+
+TEST_CASE("décodage d’un joueur qui accélère", "[morse]") {
+    static morse_player_t p;
+    player_init(&p);
+    player_send(&p, "PARIS ", MORSE_DEFAULT_WPM, 0);
+    player_send(&p, "PARIS ", 12, 0);
+    player_send(&p, "PARIS", 25, 0);
+    TEST_ASSERT_EQUAL_STRING("PARIS PARIS PARIS", player_stop(&p));
+}
+
+TEST_CASE("lettre de plus de cinq symboles", "[morse]") {
+    static morse_player_t p;
+    player_init(&p);
+    for (int i = 0; i < 6; i++) {
+        player_edge(&p, true);
+        p.now_us += 200000;
+        player_edge(&p, false);
+        p.now_us += 200000;
+    }
+    TEST_ASSERT_EQUAL_STRING("?", player_stop(&p));
+}
+
+TEST_CASE("rebonds ignorés", "[morse]") {
+    static morse_player_t p;
+    player_init(&p);
+    player_edge(&p, true);                // Point de 200 ms coupé par un rebond
+    p.now_us += 100000;
+    player_edge(&p, false);
+    p.now_us += 2000;
+    player_edge(&p, true);
+    p.now_us += 98000;
+    player_edge(&p, false);
+    TEST_ASSERT_EQUAL_STRING("E", player_stop(&p));
+}
@@ -0,0 +1,44 @@
+# ======================================================================
+#  Tests unitaires des composants (application test/, Unity)
+#
+#  Tous les TEST_CASE liés dans test/main sont exécutés au démarrage ; le
+#  bilan Unity "N Tests F Failures I Ignored" doit être sans échec.
+#
+#     cd test
+#     idf.py -B build_linux --preview set-target linux build
+#     pytest pytest_unit.py --target linux -m host_test --build-dir build_linux
+#     idf.py -B build_esp32 set-target esp32 build
+#     pytest pytest_unit.py --target esp32 -m qemu --build-dir build_esp32
+# ======================================================================
+import re
+import subprocess
+
+import pytest
+from pytest_embedded_idf.app import IdfApp
+from pytest_embedded_idf.utils import idf_parametrize
+from pytest_embedded_qemu.dut import QemuDut
+
+SUMMARY = re.compile(r'(\d+) Tests (\d+) Failures (\d+) Ignored')
+
+
+def check(output: str) -> None:
+    m = SUMMARY.search(output)
+    assert m, output[-4000:]
+    assert int(m.group(2)) == 0, output[-4000:]
+
+
+@pytest.mark.host_test
+@idf_parametrize('target', ['linux'], indirect=['target'])
+def test_unit_linux(app: IdfApp) -> None:
+    run = subprocess.run([app.elf_file], timeout=600,
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, errors='replace')
+    check(run.stdout)
+    assert run.returncode == 0, run.stdout[-4000:]
+
+
+@pytest.mark.host_test
+@pytest.mark.qemu
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_unit_qemu(dut: QemuDut) -> None:
+    m = dut.expect(SUMMARY, timeout=600)
+    assert int(m.group(2)) == 0, 'tests unitaires en échec (voir la console)'
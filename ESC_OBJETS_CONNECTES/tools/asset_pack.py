@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+# ======================================================================
+#  Outil : asset_pack.py
+#  Description : Construit le paquet de ressources de la partition
+#                "assets" (format décrit dans assets.h)
+#  Utilisation :
+#     python tools/asset_pack.py assets/pack.json -o assets.bin
+#  Flash seul (sans reflasher l’application) :
+#     parttool.py write_partition --partition-name assets --input assets.bin
+# ======================================================================
+
+import argparse
+import json
+import os
+import struct
+import sys
+import zlib
+
+import scenario_pack
+
+ASSET_PACK_MAGIC = 0x314B5041  # "APK1"
+ASSET_PACK_FORMAT = 1
+ASSET_NAME_LEN = 12
+ASSET_TYPES = {'scenario': 1, 'glyphs': 2}
+LCD_GLYPH_SLOTS = 8
+LCD_GLYPH_BASE = 8  # Code affiché du premier caractère personnalisé
+
+HEADER = struct.Struct('<IIHHIII')
+ENTRY = struct.Struct('<12sB3xII')
+
+
+def load_json(base, path):
+    with open(os.path.join(base, path), encoding='utf-8') as f:
+        return json.load(f)
+
+
+def pack_glyphs(glyphs):
+    """Retourne (données CGRAM, table caractère → code LCD)."""
+    if len(glyphs) > LCD_GLYPH_SLOTS:
+        raise ValueError('au plus 8 caractères personnalisés')
+    data = bytearray()
+    charmap = {}
+    for slot, (char, rows) in enumerate(glyphs.items()):
+        if len(rows) != 8:
+            raise ValueError(f'{char} : 8 lignes attendues')
+        data += bytes(int(r, 2) & 0x1F for r in rows)
+        charmap[char] = chr(LCD_GLYPH_BASE + slot)
+    return bytes(data), charmap
+
+
+def build(manifest, base):
+    entries = []
+    charmap = {}
+    if 'glyphs' in manifest:
+        data, charmap = pack_glyphs(load_json(base, manifest['glyphs']))
+        entries.append(('glyphs', 'glyphs', data))
+
+    for asset in manifest['assets']:
+        kind = asset['type']
+        if kind == 'scenario':
+            data = scenario_pack.pack(load_json(base, asset['source']), charmap)
+        else:
+            raise ValueError(f'type inconnu : {kind}')
+        entries.append((asset['name'], kind, data))
+
+    # Index puis données, chaque ressource alignée sur 4 octets
+    offset = HEADER.size + ENTRY.size * len(entries)
+    index = bytearray()
+    body = bytearray()
+    for name, kind, data in entries:
+        if len(name) > ASSET_NAME_LEN:
+            raise ValueError(f'{name} : nom trop long')
+        index += ENTRY.pack(name.encode('ascii'), ASSET_TYPES[kind], offset + len(body), len(data))
+        body += data + b'\0' * (-len(data) % 4)
+
+    size = offset + len(body)
+    after_crc = struct.pack('<HHIII', ASSET_PACK_FORMAT, len(entries), size,
+                            manifest.get('version', 0), 0) + index + body
+    return struct.pack('<II', ASSET_PACK_MAGIC, zlib.crc32(after_crc)) + after_crc
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Construit le paquet de ressources')
+    parser.add_argument('manifest', help='description du paquet (JSON)')
+    parser.add_argument('-o', '--output', required=True, help='image binaire produite')
+    args = parser.parse_args()
+
+    with open(args.manifest, encoding='utf-8') as f:
+        manifest = json.load(f)
+    blob = build(manifest, os.path.dirname(os.path.abspath(args.manifest)))
+    with open(args.output, 'wb') as f:
+        f.write(blob)
+    print(f'{args.output} : {len(blob)} octets')
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+# ======================================================================
+#  Outil : bench_compare.py
+#  Description : Extrait les lignes "BENCH {...}" d’une console (tests
+#                "[bench]" de test/main/test_bench.c) et les compare à une
+#                référence enregistrée
+#  Utilisation :
+#     idf.py monitor | tee bench.log          (application test/)
+#     python tools/bench_compare.py bench.log --save bench_esp32.json
+#     python tools/bench_compare.py bench.log -b bench_esp32.json [-t 10]
+#  Code de retour 1 si une médiane ou un p99 dépasse la référence de plus
+#  de t % (défaut 10). Les mesures sont rangées par (cible, nom) : une
+#  référence QEMU ne se compare qu’à une autre exécution QEMU.
+# ======================================================================
+
+import argparse
+import json
+import sys
+
+PREFIX = 'BENCH '
+METRICS = ('p50', 'p99')
+
+
+def parse(lines):
+    """Retourne {"cible/nom": mesure} des lignes BENCH trouvées."""
+    results = {}
+    for line in lines:
+        i = line.find(PREFIX)
+        if i < 0:
+            continue
+        try:
+            m = json.loads(line[i + len(PREFIX):])
+        except json.JSONDecodeError:
+            continue                       # Ligne coupée par un autre log
+        results[f"{m['target']}/{m['name']}"] = m
+    return results
+
+
+def compare(current, baseline, tolerance):
+    """Affiche l’écart de chaque mesure ; retourne le nombre de régressions."""
+    regressions = 0
+    print(f"{'mesure':32} {'unité':>6} {'p50':>12} {'écart':>8} {'p99':>12} {'écart':>8}")
+    for key in sorted(current):
+        m = current[key]
+        ref = baseline.get(key)
+        cols = []
+        for metric in METRICS:
+            if ref is None or ref['unit'] != m['unit'] or ref[metric] == 0:
+                cols.append(f"{m[metric]:>12} {'—':>8}")
+                continue
+            delta = (m[metric] - ref[metric]) * 100 / ref[metric]
+            mark = ' !' if delta > tolerance else ''
+            regressions += delta > tolerance
+            cols.append(f'{m[metric]:>12} {delta:+7.1f}%{mark}')
+        print(f"{key:32} {m['unit']:>6} {' '.join(cols)}")
+    for key in sorted(set(baseline) - set(current)):
+        print(f'{key:32} absente de cette exécution')
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare les mesures des pilotes à une référence')
+    parser.add_argument('log', help='console de l’application test/ ("-" : entrée standard)')
+    parser.add_argument('-b', '--baseline', help='référence JSON (écrite par --save)')
+    parser.add_argument('-t', '--tolerance', type=float, default=10.0, help='écart toléré en %% (défaut 10)')
+    parser.add_argument('--save', help='enregistre les mesures comme nouvelle référence')
+    args = parser.parse_args()
+
+    if args.log == '-':
+        current = parse(sys.stdin)
+    else:
+        with open(args.log, encoding='utf-8', errors='replace') as f:
+            current = parse(f)
+    if not current:
+        print('Aucune ligne BENCH trouvée', file=sys.stderr)
+        return 1
+
+    if args.save:
+        with open(args.save, 'w', encoding='utf-8') as f:
+            json.dump(current, f, indent=2, sort_keys=True)
+            f.write('\n')
+
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline, encoding='utf-8') as f:
+            baseline = json.load(f)
+    regressions = compare(current, baseline, args.tolerance)
+    if regressions:
+        print(f'{regressions} régression(s) au-delà de {args.tolerance:g} %', file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+# ======================================================================
+#  Outil : boot_compare.py
+#  Description : Met côte à côte les bilans "boot" (boot_prof.c) de
+#                plusieurs démarrages, par exemple avec et sans
+#                sdkconfig.fastboot
+#  Utilisation :
+#     python tools/boot_compare.py build_esp32_qemu/boot.log \
+#            build_esp32_qemu_fastboot/boot.log        (test_boot_breakdown)
+#     idf.py monitor | tee boot.log                     (carte)
+#  Chaque fichier est une console ou un boot.log ; seul le dernier bilan
+#  de chaque fichier compte. Colonnes : heure de fin de l’étape et, entre
+#  parenthèses, sa durée (depuis l’étape précédente, ou propre pour une
+#  initialisation concurrente).
+# ======================================================================
+
+import argparse
+import os
+import re
+import sys
+
+STEP = re.compile(r'boot: (\S+) +(\d+\.\d) ms  \((?:durée |\+)(\d+\.\d)\)')
+TOTAL = re.compile(r'boot: Invite affichée (\d+\.\d) ms')
+
+
+def parse(lines):
+    """Retourne ([(étape, fin, durée)], total) du dernier bilan trouvé."""
+    steps, total = [], None
+    for line in lines:
+        m = TOTAL.search(line)
+        if m:
+            total = float(m.group(1))
+            continue
+        m = STEP.search(line)
+        if m:
+            if total is not None:              # Nouveau démarrage
+                steps, total = [], None
+            steps.append((m.group(1), float(m.group(2)), float(m.group(3))))
+    return steps, total
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare des bilans de démarrage')
+    parser.add_argument('logs', nargs='+', help='consoles ou boot.log')
+    args = parser.parse_args()
+
+    runs = []
+    for path in args.logs:
+        with open(path, encoding='utf-8', errors='replace') as f:
+            steps, total = parse(f)
+        if total is None:
+            print(f'{path} : aucun bilan "boot" complet', file=sys.stderr)
+            return 1
+        runs.append((os.path.basename(os.path.dirname(os.path.abspath(path))) or path, steps, total))
+
+    phases = []
+    for _, steps, _ in runs:
+        phases += [s[0] for s in steps if s[0] not in phases]
+
+    width = 22
+    print(f"{'étape (ms)':14}" + ''.join(f'{name[-width:]:>{width}}' for name, _, _ in runs))
+    for phase in phases:
+        cells = []
+        for _, steps, _ in runs:
+            found = [s for s in steps if s[0] == phase]
+            cells.append(f'{found[0][1]:.1f} ({found[0][2]:.1f})' if found else '-')
+        print(f'{phase:14}' + ''.join(f'{c:>{width}}' for c in cells))
+    print(f"{'invite':14}" + ''.join(f'{total:>{width}.1f}' for _, _, total in runs))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,230 @@
+#!/usr/bin/env python
+# ======================================================================
+#  Outil : footprint.py
+#  Description : Occupation flash / IRAM / DRAM de chaque composant, lue
+#                dans le fichier .map de l’édition de liens (esp32)
+#  Utilisation :
+#     idf.py footprint                        (cible de main/CMakeLists.txt)
+#     python tools/footprint.py build/ESC_OBJETS_CONNECTES.map \
+#            [-p partitions.csv] [--budget 0xE0000 | --budget-from partitions_prod.csv] [-n 20]
+#  Colonnes : code en flash (.flash.text), constantes en flash
+#  (.flash.rodata), IRAM (vecteurs + .iram0.text), DRAM initialisée
+#  (.dram0.data, copiée depuis la flash) et non initialisée (.dram0.bss).
+#  L’image flashée contient tout sauf .bss. Code de retour 1 si l’image
+#  dépasse une partition d’application ou le budget : --budget (octets),
+#  ou --budget-from, le plus petit emplacement d’application d’une autre
+#  table (emplacement OTA de la table de production).
+# ======================================================================
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+# Section de sortie → colonne
+COLUMNS = ('flash_text', 'flash_rodata', 'iram', 'dram_data', 'dram_bss')
+SECTIONS = {
+    '.flash.text': 'flash_text',
+    '.flash.rodata': 'flash_rodata',
+    '.flash.appdesc': 'flash_rodata',
+    '.iram0.vectors': 'iram',
+    '.iram0.text': 'iram',
+    '.iram0.data': 'iram',
+    '.dram0.data': 'dram_data',
+    '.dram0.bss': 'dram_bss',
+    '.noinit': 'dram_bss',
+}
+IN_IMAGE = ('flash_text', 'flash_rodata', 'iram', 'dram_data')
+
+OUTPUT_SECTION = re.compile(r'^(\.\S+)')
+INPUT_SECTION = re.compile(r'^ (\S+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*))?$')
+CONTINUATION = re.compile(r'^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*)$')
+BEFORE_RELAXING = re.compile(r'^\s+0x([0-9a-f]+) \(size before relaxing\)$')
+ARCHIVE = re.compile(r'(?:^|[/\\])lib([^/\\(]+)\.a\(')
+
+
+def component_of(obj):
+    """esp-idf/lcd/liblcd.a(lcd.c.obj) → lcd ; objet isolé → son nom."""
+    m = ARCHIVE.search(obj)
+    if m:
+        return m.group(1)
+    return re.split(r'[/\\]', obj.split('(')[0])[-1]
+
+
+def attribute(entries, usage, column):
+    """Répartit une section de sortie entre les composants.
+    Les tailles du .map se recouvrent (chaînes fusionnées .str1.*,
+    relaxation) : chaque entrée ne compte que jusqu’à l’adresse suivante.
+    Les zones de chaînes fusionnées sont partagées au prorata des tailles
+    avant fusion."""
+    starts = sorted({e[0] for e in entries})
+    following = dict(zip(starts, starts[1:]))
+    groups = {}
+    for e in entries:
+        groups.setdefault(e[0], []).append(e)
+    merged = 0
+    weights = []                            # (composant, taille avant fusion)
+    for addr, group in groups.items():
+        span = max(e[1] for e in group)
+        if addr in following:
+            span = min(span, following[addr] - addr)
+        plain = [e for e in group if not e[2]]
+        if plain:
+            comp = max(plain, key=lambda e: e[1])[3]
+            usage[comp][column] += span
+        else:
+            merged += span
+        weights += [(e[3], e[4]) for e in group if e[2]]
+    total = sum(w for _, w in weights)
+    for comp, w in weights:
+        if total:
+            usage[comp][column] += round(merged * w / total)
+
+
+def parse(lines):
+    """Retourne {composant: {colonne: octets}} des sections chargées."""
+    usage = {}
+    sections = []                           # (colonne, [entrées])
+    entries = None
+    pending = None                          # Nom d’entrée seul sur sa ligne
+    last = None                             # Dernière entrée lue
+    started = False
+    for line in lines:
+        line = line.rstrip('\n')
+        if not started:
+            started = line.startswith('Linker script and memory map')
+            continue
+        m = OUTPUT_SECTION.match(line)
+        if m:
+            column = SECTIONS.get(m.group(1))
+            entries = None
+            if column is not None:
+                entries = []
+                sections.append((column, entries))
+            pending = last = None
+            continue
+        if entries is None:
+            continue
+        m = BEFORE_RELAXING.match(line)
+        if m:
+            if last is not None:
+                last[4] = int(m.group(1), 16)
+            continue
+        name = None
+        m = INPUT_SECTION.match(line)
+        if m and not m.group(1).startswith(('*', '0x')):
+            if m.group(2) is None:
+                pending = m.group(1)
+                continue
+            name, addr, size, obj = m.group(1), int(m.group(2), 16), int(m.group(3), 16), m.group(4)
+        elif pending:
+            m = CONTINUATION.match(line)
+            if m:
+                name, addr, size, obj = pending, int(m.group(1), 16), int(m.group(2), 16), m.group(3)
+        pending = last = None
+        if name is None:
+            continue
+        comp = component_of(obj)
+        usage.setdefault(comp, dict.fromkeys(COLUMNS, 0))
+        # [adresse, taille, chaînes fusionnées, composant, taille avant fusion]
+        last = [addr, size, '.str1.' in name, comp, size]
+        entries.append(last)
+
+    for column, entries in sections:
+        attribute(entries, usage, column)
+    return {comp: cols for comp, cols in usage.items() if any(cols.values())}
+
+
+def parse_size(text):
+    """Taille de partitions.csv : 0x..., décimal, K ou M."""
+    text = text.strip().upper()
+    mult = {'K': 1024, 'M': 1024 * 1024}.get(text[-1:], 1)
+    return int(text.rstrip('KM'), 0) * mult
+
+
+def app_partitions(path):
+    """[(nom, taille)] des partitions d’application (factory, ota_N)."""
+    apps = []
+    with open(path, encoding='utf-8') as f:
+        for row in csv.reader(line for line in f if line.strip() and not line.lstrip().startswith('#')):
+            row = [c.strip() for c in row]
+            if len(row) >= 5 and row[1] == 'app' and row[4]:
+                apps.append((row[0], parse_size(row[4])))
+    return apps
+
+
+def kib(n):
+    return f'{n / 1024:.1f}'
+
+
+def report(usage, top):
+    """Tableau trié par occupation de l’image ; retourne les totaux."""
+    totals = dict.fromkeys(COLUMNS, 0)
+    for cols in usage.values():
+        for c in COLUMNS:
+            totals[c] += cols[c]
+
+    def image(cols):
+        return sum(cols[c] for c in IN_IMAGE)
+
+    print(f"{'composant (Kio)':24} {'image':>8} {'code':>8} {'const':>8} {'IRAM':>8} {'.data':>8} {'.bss':>8}")
+    rows = sorted(usage.items(), key=lambda kv: (image(kv[1]), kv[1]['dram_bss']), reverse=True)
+    others = dict.fromkeys(COLUMNS, 0)
+    for i, (name, cols) in enumerate(rows):
+        if top and i >= top:
+            for c in COLUMNS:
+                others[c] += cols[c]
+            continue
+        print(f'{name:24} {kib(image(cols)):>8} ' + ' '.join(f'{kib(cols[c]):>8}' for c in COLUMNS))
+    if top and len(rows) > top:
+        print(f'{f"({len(rows) - top} autres)":24} {kib(image(others)):>8} '
+              + ' '.join(f'{kib(others[c]):>8}' for c in COLUMNS))
+    print(f"{'total':24} {kib(image(totals)):>8} " + ' '.join(f'{kib(totals[c]):>8}' for c in COLUMNS))
+    return totals
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Occupation mémoire par composant')
+    parser.add_argument('map', help='fichier .map du firmware (build/<projet>.map)')
+    parser.add_argument('-p', '--partitions', help='table des partitions (partitions.csv)')
+    parser.add_argument('--budget', type=lambda s: int(s, 0), help='taille maximale de l’image (ex. 0xE0000 : emplacement OTA)')
+    parser.add_argument('--budget-from', metavar='CSV', help='budget : plus petite partition d’application de cette table')
+    parser.add_argument('-n', '--top', type=int, default=0, help='nombre de composants affichés (défaut : tous)')
+    args = parser.parse_args()
+
+    with open(args.map, encoding='utf-8', errors='replace') as f:
+        usage = parse(f)
+    if not usage:
+        print('Aucune section chargée trouvée', file=sys.stderr)
+        return 1
+    totals = report(usage, args.top)
+
+    # Image réelle (en-têtes et alignements compris) si elle est à côté
+    used = sum(totals[c] for c in IN_IMAGE)
+    binary = os.path.splitext(args.map)[0] + '.bin'
+    if os.path.exists(binary):
+        used = os.path.getsize(binary)
+        print(f'\nImage {os.path.basename(binary)} : {kib(used)} Kio')
+
+    limits = []
+    if args.partitions:
+        limits += [(f'partition "{name}"', size) for name, size in app_partitions(args.partitions)]
+    if args.budget:
+        limits.append(('budget', args.budget))
+    if args.budget_from:
+        apps = app_partitions(args.budget_from)
+        if apps:
+            name, size = min(apps, key=lambda a: a[1])
+            limits.append((f'budget "{name}"', size))
+    over = 0
+    for name, size in limits:
+        left = size - used
+        over += left < 0
+        print(f'{name:20} {kib(size):>8} Kio, utilisés {used * 100 / size:5.1f} %, reste {kib(left)} Kio'
+              + (' !' if left < 0 else ''))
+    return 1 if over else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+# ======================================================================
+#  Outil : journal_dump.py
+#  Description : Lit la partition "journal" (format décrit dans journal.h)
+#                et affiche les sessions enregistrées
+#  Utilisation :
+#     parttool.py read_partition --partition-name journal --output journal.bin
+#     python tools/journal_dump.py journal.bin             (dernière session)
+#     python tools/journal_dump.py journal.bin --list
+#     python tools/journal_dump.py journal.bin -s 12 -o session.bin
+#  session.bin ne contient que la session choisie : une fois écrite dans la
+#  partition d’une autre carte, CONFIG_GAME_REPLAY la rejoue.
+# ======================================================================
+
+import argparse
+import struct
+import sys
+
+JOURNAL_MAGIC = 0x314E524A  # "JRN1"
+JOURNAL_SECTOR_SIZE = 4096
+JOURNAL_END = 0xFF
+
+SECTOR = struct.Struct('<IIII')
+EVENTS = ['key', 'button', 'timer', 'net']
+
+
+def sectors(log):
+    """Retourne {(session, seq): index} des secteurs valides."""
+    found = {}
+    for i in range(len(log) // JOURNAL_SECTOR_SIZE):
+        magic, seq, session, _ = SECTOR.unpack_from(log, i * JOURNAL_SECTOR_SIZE)
+        if magic == JOURNAL_MAGIC:
+            found[(session, seq)] = i
+    return found
+
+
+def records(log, index):
+    """Enregistrements (type, arg, délai µs) d’un secteur."""
+    p = index * JOURNAL_SECTOR_SIZE + SECTOR.size
+    end = (index + 1) * JOURNAL_SECTOR_SIZE
+    while end - p >= 3 and log[p] != JOURNAL_END:
+        kind, arg = log[p], log[p + 1]
+        p += 2
+        dt, shift = 0, 0
+        while True:
+            if p >= end:
+                raise ValueError(f'secteur {index} : enregistrement tronqué')
+            b = log[p]
+            p += 1
+            dt |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                break
+        yield kind, arg, dt
+
+
+def session_events(log, found, session):
+    """Événements (t µs, type, arg) d’une session, dans l’ordre."""
+    t = 0
+    for seq in sorted(s for (sess, s) in found if sess == session):
+        for kind, arg, dt in records(log, found[(session, seq)]):
+            t += dt
+            yield t, kind, arg
+
+
+def describe(kind, arg):
+    name = EVENTS[kind] if kind < len(EVENTS) else f'type{kind}'
+    if name == 'key':
+        return f'{name:7} {chr(arg)!r}'
+    if name == 'button':
+        return f'{name:7} {"appui" if arg else "relâché"}'
+    if name == 'timer':
+        return f'{name:7} #{arg}'
+    return f'{name:7} {arg}'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Affiche les sessions de la partition journal')
+    parser.add_argument('dump', help='copie de la partition (parttool.py read_partition)')
+    parser.add_argument('-l', '--list', action='store_true', help='liste les sessions')
+    parser.add_argument('-s', '--session', type=int, help='session à afficher (défaut : la dernière)')
+    parser.add_argument('-o', '--output', help='image de partition contenant seulement cette session')
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as f:
+        log = f.read()
+    found = sectors(log)
+    sessions = sorted({sess for (sess, _) in found})
+    if not sessions:
+        print('Aucune session enregistrée')
+        return 1
+
+    if args.list:
+        for sess in sessions:
+            events = list(session_events(log, found, sess))
+            duration = events[-1][0] / 1e6 if events else 0
+            print(f'session {sess:5} : {len(events):5} événements, {duration:8.1f} s')
+        return 0
+
+    session = sessions[-1] if args.session is None else args.session
+    if session not in sessions:
+        print(f'Session {session} absente')
+        return 1
+
+    for t, kind, arg in session_events(log, found, session):
+        print(f'{t / 1e6:10.6f}  {describe(kind, arg)}')
+
+    if args.output:
+        image = bytearray(b'\xff' * len(log))
+        for (sess, _), i in found.items():
+            if sess == session:
+                base = i * JOURNAL_SECTOR_SIZE
+                image[base:base + JOURNAL_SECTOR_SIZE] = log[base:base + JOURNAL_SECTOR_SIZE]
+        with open(args.output, 'wb') as f:
+            f.write(image)
+        print(f'{args.output} : session {session}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
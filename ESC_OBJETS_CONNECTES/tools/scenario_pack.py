@@ -0,0 +1,165 @@
+#!/usr/bin/env python
+# ======================================================================
+#  Outil : scenario_pack.py
+#  Description : Compile un scénario JSON en image binaire
+#                (format décrit dans scenario.h)
+#  Utilisation :
+#     python tools/scenario_pack.py scenarios/b947d.json -o scenario.bin
+#  Le scénario est normalement livré dans le paquet de ressources
+#  (tools/asset_pack.py) ; cet outil sert surtout à le vérifier seul.
+# ======================================================================
+
+import argparse
+import hashlib
+import json
+import os
+import struct
+import sys
+
+SCN_MAGIC = 0x314E4353  # "SCN1"
+SCN_VERSION = 4
+SCN_STATE_NONE = 0xFF
+SCN_STATE_STAY = 0xFE
+SCN_NO_COUNTDOWN = 0xFF
+SCN_TIME_MAX = 5999
+SCN_CODE_MAX = 16
+SECRET_SALT_LEN = 16
+INPUT_LINE_MASKED = 0x01
+INPUT_LINE_AUTO_SUBMIT = 0x02
+SCN_INPUT_MORSE = 0x80
+
+EVENTS = ['key', 'button', 'timeout', 'code_ok', 'code_bad', 'net']
+OPS = ['end', 'lcd_clear', 'lcd_print', 'led_on', 'led_off', 'led_effect', 'morse', 'timer']
+LEDS = {'ep1': 0, 'ep2': 1, 'err': 2}
+EFFECTS = {'breathe': 0, 'pulse': 1, 'success': 2, 'error': 3}
+
+HEADER = struct.Struct('<IHBBHHIHBBHHBBBB')
+
+
+class Packer:
+    def __init__(self, charmap):
+        self.charmap = charmap
+        self.actions = []
+        self.secrets = []
+        self.strings = bytearray()
+        self.string_index = {}
+
+    def string(self, text):
+        """Ajoute une chaîne (dédupliquée) et retourne son décalage."""
+        if text not in self.string_index:
+            self.string_index[text] = len(self.strings)
+            lcd = ''.join(self.charmap.get(c, c) for c in text)
+            self.strings += lcd.encode('ascii') + b'\0'
+        return self.string_index[text]
+
+    def secret(self, code):
+        """Ajoute l’empreinte salée SHA-256(sel || code) et retourne son indice.
+        Le code en clair n’est jamais écrit dans l’image."""
+        salt = os.urandom(SECRET_SALT_LEN)
+        self.secrets.append(salt + hashlib.sha256(salt + code.encode('ascii')).digest())
+        return len(self.secrets) - 1
+
+    def led_mask(self, names):
+        names = names if isinstance(names, list) else [names]
+        return sum(1 << LEDS[n] for n in names)
+
+    def action(self, spec):
+        op, args = spec[0], spec[1:]
+        a, b = 0, 0
+        if op == 'lcd_print':
+            a, b = args[0], self.string(args[1])
+        elif op in ('led_on', 'led_off'):
+            a = self.led_mask(args[0])
+        elif op == 'led_effect':
+            a, b = LEDS[args[0]], EFFECTS[args[1]]
+        elif op == 'morse':
+            b = self.string(args[0])
+        elif op == 'timer':
+            if not 0 <= args[0] <= 0xFFFF:
+                raise ValueError('timer : délai de 0 à 65535 ms')
+            b = args[0]
+        return struct.pack('<BBH', OPS.index(op), a, b)
+
+    def actions_block(self, specs):
+        """Retourne (premier indice, nombre) d’une liste d’actions."""
+        first = len(self.actions)
+        self.actions += [self.action(s) for s in specs]
+        return first, len(specs)
+
+
+def pack(scenario, charmap=None):
+    """Compile un scénario ; charmap remplace des caractères (accents)
+    par les codes des caractères LCD personnalisés."""
+    names = list(scenario['states'])
+    if len(names) >= SCN_STATE_STAY:
+        raise ValueError('trop d’états')
+    p = Packer(charmap or {})
+    states = bytearray()
+    trans = bytearray()
+
+    for name in names:
+        st = scenario['states'][name]
+        first, count = p.actions_block(st.get('enter', []))
+        code = st.get('code', '')
+        if len(code) > SCN_CODE_MAX:
+            raise ValueError(f'{name} : code trop long')
+        secret = p.secret(code) if code else 0
+        # "morse" : code tapé au bouton, validé dès qu’il est complet
+        flags = ((INPUT_LINE_MASKED if st.get('masked') else 0) |
+                 (INPUT_LINE_AUTO_SUBMIT if st.get('auto_submit') or st.get('morse') else 0) |
+                 (SCN_INPUT_MORSE if st.get('morse') else 0))
+        states += struct.pack('<HBBHHB3x', first, count, len(code), secret,
+                              st.get('timeout_ms', 0), flags)
+
+        on = st.get('on', {})
+        for ev in on:
+            if ev not in EVENTS:
+                raise ValueError(f'{name} : événement inconnu {ev}')
+        for ev in EVENTS:
+            if ev not in on:
+                trans += struct.pack('<BBH', SCN_STATE_NONE, 0, 0)
+                continue
+            t = on[ev]
+            target = names.index(t['to']) if 'to' in t else SCN_STATE_STAY
+            first, count = p.actions_block(t.get('do', []))
+            trans += struct.pack('<BBH', target, count, first)
+
+    # Temps de partie : limite, compte à rebours, indices, blocage
+    session = scenario.get('session', {})
+    limit = session.get('time_limit_s', 0)
+    if limit > SCN_TIME_MAX:
+        raise ValueError(f'temps de partie limité à {SCN_TIME_MAX} s')
+    expired = names.index(session['expired']) if 'expired' in session else SCN_STATE_NONE
+    row, col = session.get('countdown', (SCN_NO_COUNTDOWN, 0))
+    lockout = session.get('lockout', {})
+    hints = bytearray()
+    for hint in sorted(session.get('hints', []), key=lambda h: h['after_s']):
+        first, count = p.actions_block(hint['do'])
+        hints += struct.pack('<HHBx', hint['after_s'], first, count)
+
+    strings = bytes(p.strings) or b'\0'
+    secrets = b''.join(p.secrets)
+    size = (HEADER.size + len(states) + len(trans) + len(hints) + 4 * len(p.actions) +
+            len(secrets) + len(strings))
+    header = HEADER.pack(SCN_MAGIC, SCN_VERSION, len(names), names.index(scenario['initial']),
+                         len(p.actions), len(strings), size, len(p.secrets),
+                         len(hints) // 6, expired, limit, lockout.get('seconds', 0),
+                         lockout.get('failures', 0), row, col, 0)
+    return header + states + trans + hints + b''.join(p.actions) + secrets + strings
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('input', help='scénario JSON')
+    parser.add_argument('-o', '--output', required=True, help='image binaire produite')
+    args = parser.parse_args()
+
+    with open(args.input, encoding='utf-8') as f:
+        blob = pack(json.load(f))
+    with open(args.output, 'wb') as f:
+        f.write(blob)
+    print(f'{args.output} : {len(blob)} octets')
+
+
+if __name__ == '__main__':
+    sys.exit(main())